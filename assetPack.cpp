@@ -0,0 +1,143 @@
+#include "assetPack.h"
+#include "assetPackFormat.h"
+
+#ifdef PAWN_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// The pack CMake builds (PAWN_ASSET_PACK_PATH) is linked in as read-only data, so a plain build stays self-contained.
+#if defined(__APPLE__)
+#define ASSET_SYMBOL(name) "_" #name
+#define ASSET_SECTION ".const_data"
+#define ASSET_SECTION_END ".text"
+#else
+#define ASSET_SYMBOL(name) #name
+#define ASSET_SECTION ".pushsection .rodata"
+#define ASSET_SECTION_END ".popsection"
+#endif
+
+__asm__(
+    ASSET_SECTION "\n"
+    ".balign 16\n"
+    ".globl " ASSET_SYMBOL(embeddedAssetPack) "\n"
+    ASSET_SYMBOL(embeddedAssetPack) ":\n"
+    ".incbin \"" PAWN_ASSET_PACK_PATH "\"\n"
+    ".globl " ASSET_SYMBOL(embeddedAssetPackEnd) "\n"
+    ASSET_SYMBOL(embeddedAssetPackEnd) ":\n"
+    ASSET_SECTION_END "\n"
+);
+
+extern "C" const unsigned char embeddedAssetPack[];
+extern "C" const unsigned char embeddedAssetPackEnd[];
+
+static const unsigned char* packData = nullptr;
+static size_t packSize = 0;
+
+static std::mutex decompressedMutex;
+static std::unordered_map<std::string, std::vector<unsigned char>> decompressed;   // Nodes never move, so pointers stay valid
+
+static bool validPack(const unsigned char* data, size_t size) {
+    AssetPackHeader header{};
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, assetPackMagic, sizeof(header.magic)) != 0 || header.version != assetPackVersion ||
+        size < sizeof(header) + static_cast<size_t>(header.entryCount) * sizeof(AssetPackEntry)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        AssetPackEntry entry{};
+        memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (entry.offset > size || entry.packedSize > size - entry.offset || entry.name[sizeof(entry.name) - 1] != '\0') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool openAssetPack(const char* path) {
+    if (!path) {
+        packData = embeddedAssetPack;
+        packSize = static_cast<size_t>(embeddedAssetPackEnd - embeddedAssetPack);
+        return validPack(packData, packSize);
+    }
+
+    int fd = open(path, O_RDONLY);
+    struct stat info{};
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        std::cerr << "❌ Cannot open asset pack " << path << "\n";
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    // Mapped for the lifetime of the process; stored assets are read straight from the page cache.
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED || !validPack(static_cast<const unsigned char*>(mapped), static_cast<size_t>(info.st_size))) {
+        std::cerr << "❌ " << path << " is not a valid asset pack\n";
+        if (mapped != MAP_FAILED) {
+            munmap(mapped, static_cast<size_t>(info.st_size));
+        }
+        return false;
+    }
+
+    packData = static_cast<const unsigned char*>(mapped);
+    packSize = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+Asset loadAsset(std::string_view name) {
+    AssetPackHeader header{};
+    memcpy(&header, packData, sizeof(header));
+
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        AssetPackEntry entry{};
+        memcpy(&entry, packData + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (name != entry.name) {
+            continue;
+        }
+
+        if (entry.codec == AssetCodec::Stored) {
+            return { packData + entry.offset, static_cast<size_t>(entry.size) };
+        }
+
+        std::lock_guard lock(decompressedMutex);
+        auto [it, inserted] = decompressed.try_emplace(entry.name);
+        if (inserted) {
+#ifdef PAWN_HAVE_ZSTD
+            it->second.resize(entry.size);
+            size_t size = ZSTD_decompress(it->second.data(), it->second.size(), packData + entry.offset, entry.packedSize);
+            if (ZSTD_isError(size) || size != entry.size) {
+                std::cerr << "❌ Decompressing asset " << entry.name << " failed\n";
+                decompressed.erase(it);
+                return {};
+            }
+#else
+            std::cerr << "❌ Asset " << entry.name << " is zstd-compressed, but this build has no zstd\n";
+            decompressed.erase(it);
+            return {};
+#endif
+        }
+        return { it->second.data(), it->second.size() };
+    }
+
+    std::cerr << "❌ Unknown asset: " << name << "\n";
+    return {};
+}
@@ -0,0 +1,32 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+#include <cstddef>
+#include <string_view>
+
+struct Asset {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+bool openAssetPack(
+    /*
+     * Use the pack embedded in the executable (`path` == nullptr) or memory-map the pack at `path`,
+     * which lets assets be swapped without recompiling. Call once, before any loadAsset().
+     */
+
+    const char* path = nullptr
+);
+
+Asset loadAsset(
+    /*
+     * Look up an asset by name. Stored entries point straight into the pack (no copy);
+     * compressed entries are decompressed on first use and cached for the rest of the run.
+     * Safe to call from worker threads. Returns an empty Asset if the name is unknown.
+     */
+
+    std::string_view name
+);
+
+#endif //ASSETPACK_H
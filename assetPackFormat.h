@@ -0,0 +1,33 @@
+#ifndef ASSETPACKFORMAT_H
+#define ASSETPACKFORMAT_H
+#include <cstdint>
+
+// On-disk layout of assets.pack, shared by tools/packAssets.cpp and assetPack.cpp (little-endian).
+// The header is followed by `entryCount` entries, then the payloads, each aligned to 16 bytes.
+
+constexpr char assetPackMagic[8] = { 'P', 'A', 'W', 'N', 'P', 'A', 'C', 'K' };
+constexpr uint32_t assetPackVersion = 1;
+
+enum class AssetCodec : uint32_t {
+    Stored = 0,     // Payload is the file itself; already-compressed images stay like this
+    Zstd = 1
+};
+
+struct AssetPackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+};
+
+struct AssetPackEntry {
+    char name[48];          // Null-terminated
+    AssetCodec codec;
+    uint32_t reserved;
+    uint64_t offset;        // From the start of the pack
+    uint64_t packedSize;
+    uint64_t size;          // After decompression
+};
+
+static_assert(sizeof(AssetPackHeader) == 16 && sizeof(AssetPackEntry) == 80, "assets.pack layout must not depend on the compiler");
+
+#endif //ASSETPACKFORMAT_H
@@ -0,0 +1,299 @@
+#include "asyncTextureLoader.h"
+#include "mipGenerator.h"
+#include "options.h"
+#include "glState.h"
+
+#include <algorithm>
+#include <iostream>
+
+
+static GLenum formatForChannels(int channels) {
+    return (channels == 4) ? GL_RGBA :
+           (channels == 3) ? GL_RGB :
+           (channels == 1) ? GL_RED : 0;
+}
+
+static GLenum internalFormatForChannels(int channels) {
+    return (channels == 4) ? GL_RGBA8 :
+           (channels == 3) ? GL_RGB8 :
+           (channels == 1) ? GL_R8 : 0;
+}
+
+static size_t compressedBlockBytes(GLenum compressedFormat) {
+    return (compressedFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || compressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) ? 8 : 16;
+}
+
+struct LevelShape {
+    int width, height;
+    int rows;           // Texel rows, or block rows for compressed data
+    int texelsPerRow;   // 1, or 4 for block rows
+    size_t rowBytes;
+};
+
+static LevelShape levelShape(const StreamedLayout& layout, int level) {
+    LevelShape shape{};
+    shape.width = std::max(1, layout.width >> level);
+    shape.height = std::max(1, layout.height >> level);
+    if (layout.compressedFormat) {
+        shape.rows = (shape.height + 3) / 4;
+        shape.texelsPerRow = 4;
+        shape.rowBytes = static_cast<size_t>((shape.width + 3) / 4) * compressedBlockBytes(layout.compressedFormat);
+    } else {
+        shape.rows = shape.height;
+        shape.texelsPerRow = 1;
+        shape.rowBytes = static_cast<size_t>(shape.width) * layout.channels;
+    }
+    return shape;
+}
+
+TextureStreamer::TextureStreamer(size_t bytesPerFrame) : bytesPerFrame(bytesPerFrame) {}
+
+TextureStreamer::~TextureStreamer() {
+    // Runs after the GL context is gone, so no GL here; shutdown() has already waited unless it was skipped.
+    for (auto& tex : textures) {
+        if (tex->job.valid()) {
+            tex->job.wait();
+        }
+    }
+}
+
+void TextureStreamer::shutdown() {
+    for (auto& tex : textures) {
+        // A worker may still be writing into the mapping, which must outlive it.
+        if (tex->job.valid()) {
+            tex->job.wait();
+        }
+        if (tex->pbo) {
+            glDeleteBuffers(1, &tex->pbo);     // Unmaps it too
+            tex->pbo = 0;
+            tex->mapped = nullptr;
+        }
+    }
+}
+
+StreamedTexture& TextureStreamer::load(const std::string& name, const unsigned char* placeholderRGBA, const StreamedLayout& layout, DecodeInto decode) {
+    auto tex = std::make_unique<StreamedTexture>();
+    tex->name = name;
+    tex->layout = layout;
+    if (tex->layout.bytes == 0) {
+        tex->layout.bytes = static_cast<size_t>(layout.width) * layout.height * layout.channels * layout.layers;
+    }
+
+    const GLenum target = layout.target();
+    tex->texture = glState.createTexture(target);
+    glState.bindTextureForEdit(target, tex->texture);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    if (layout.array) {
+        glTexImage3D(target, 0, GL_RGBA8, 1, 1, layout.layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholderRGBA);
+    } else {
+        glTexImage2D(target, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholderRGBA);
+    }
+
+    const size_t capacity = tex->layout.bytes + decodeHeadroom;
+
+    glGenBuffers(1, &tex->pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, tex->pbo);
+    if (GLEW_ARB_buffer_storage) {
+        // Coherent, so the worker's writes are visible to the upload without an explicit flush.
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+        tex->mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(capacity), flags));
+        tex->persistent = true;
+    } else {
+        // GL 3.3: a plain mapping may stay open while other buffers are in use; it is unmapped once decoded.
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+        tex->mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(capacity),
+                                                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (tex->mapped) {
+        // The worker owns `layout` until the job completes; the GL thread only reads it afterwards.
+        tex->job = std::async(std::launch::async, [decode = std::move(decode), dst = tex->mapped, capacity, &layout = tex->layout] {
+            return decode(dst, capacity, layout);
+        });
+    } else {
+        std::cerr << "❌ Mapping the pixel buffer for " << name << " failed, keeping placeholder\n";
+        glDeleteBuffers(1, &tex->pbo);
+        tex->pbo = 0;
+        tex->resident = true;
+    }
+
+    textures.push_back(std::move(tex));
+    return *textures.back();
+}
+
+void TextureStreamer::pump() {
+    size_t budget = bytesPerFrame;
+
+    for (auto& tex : textures) {
+        if (tex->resident || budget == 0) {
+            continue;
+        }
+
+        if (tex->job.valid()) {
+            if (tex->job.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                continue;
+            }
+            beginUpload(*tex, tex->job.get());
+        }
+
+        if (tex->pendingTexture) {
+            uploadRows(*tex, budget);
+        }
+    }
+
+    if (!reportedResident && allResident()) {
+        reportedResident = true;
+        std::cout << "⏱️  Time to fully loaded: " << millisecondsSinceStartup() << " ms\n";
+    }
+}
+
+bool TextureStreamer::allResident() const {
+    return std::ranges::all_of(textures, [](const auto& tex) { return tex->resident; });
+}
+
+void TextureStreamer::beginUpload(StreamedTexture& tex, bool decoded) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, tex.pbo);
+    if (!tex.persistent) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    tex.mapped = nullptr;
+
+    const StreamedLayout& layout = tex.layout;
+    if (!decoded || (!layout.compressedFormat && formatForChannels(layout.channels) == 0)) {
+        std::cerr << "❌ Decoding " << tex.name << " failed, keeping placeholder\n";
+        glDeleteBuffers(1, &tex.pbo);
+        tex.pbo = 0;
+        tex.resident = true;
+        return;
+    }
+
+    // Allocate every level up front; the rows arrive over the next few frames.
+    const GLenum target = layout.target();
+    tex.pendingTexture = glState.createTexture(target);
+    glState.bindTextureForEdit(target, tex.pendingTexture);
+    for (int level = 0; level < layout.levels; ++level) {
+        LevelShape shape = levelShape(layout, level);
+        const auto levelBytes = static_cast<GLsizei>(shape.rowBytes * shape.rows);
+        if (layout.array && layout.compressedFormat) {
+            glCompressedTexImage3D(target, level, layout.compressedFormat, shape.width, shape.height, layout.layers, 0,
+                                   levelBytes * layout.layers, nullptr);
+        } else if (layout.array) {
+            glTexImage3D(target, level, (GLint) internalFormatForChannels(layout.channels), shape.width, shape.height, layout.layers, 0,
+                         formatForChannels(layout.channels), GL_UNSIGNED_BYTE, nullptr);
+        } else if (layout.compressedFormat) {
+            glCompressedTexImage2D(target, level, layout.compressedFormat, shape.width, shape.height, 0, levelBytes, nullptr);
+        } else {
+            glTexImage2D(target, level, (GLint) internalFormatForChannels(layout.channels), shape.width, shape.height, 0,
+                         formatForChannels(layout.channels), GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+    tex.layer = 0;
+    tex.level = 0;
+    tex.rowsUploaded = 0;
+    tex.levelOffset = 0;
+}
+
+void TextureStreamer::uploadRows(StreamedTexture& tex, size_t& budget) {
+    const StreamedLayout& layout = tex.layout;
+    const GLenum target = layout.target();
+
+    // The pixels already live in the PBO; each slice is a pure GPU-side transfer.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, tex.pbo);
+    glState.bindTextureForEdit(target, tex.pendingTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    bool progressed = false;
+    while (tex.layer < layout.layers && (budget > 0 || !progressed)) {
+        LevelShape shape = levelShape(layout, tex.level);
+
+        // Always make progress, even when a single row exceeds the remaining budget.
+        int rows = std::max(1, static_cast<int>(budget / shape.rowBytes));
+        rows = std::min(rows, shape.rows - tex.rowsUploaded);
+        const size_t bytes = shape.rowBytes * rows;
+        auto* offset = reinterpret_cast<void*>(tex.levelOffset + shape.rowBytes * tex.rowsUploaded);
+
+        int y = tex.rowsUploaded * shape.texelsPerRow;
+        int height = std::min(rows * shape.texelsPerRow, shape.height - y);
+        if (layout.array && layout.compressedFormat) {
+            glCompressedTexSubImage3D(target, tex.level, 0, y, tex.layer, shape.width, height, 1,
+                                      layout.compressedFormat, static_cast<GLsizei>(bytes), offset);
+        } else if (layout.array) {
+            glTexSubImage3D(target, tex.level, 0, y, tex.layer, shape.width, height, 1,
+                            formatForChannels(layout.channels), GL_UNSIGNED_BYTE, offset);
+        } else if (layout.compressedFormat) {
+            glCompressedTexSubImage2D(target, tex.level, 0, y, shape.width, height,
+                                      layout.compressedFormat, static_cast<GLsizei>(bytes), offset);
+        } else {
+            glTexSubImage2D(target, tex.level, 0, y, shape.width, height,
+                            formatForChannels(layout.channels), GL_UNSIGNED_BYTE, offset);
+        }
+
+        tex.rowsUploaded += rows;
+        budget -= std::min(budget, bytes);
+        progressed = true;
+
+        // Layers are stored back to back, each with its levels in order.
+        if (tex.rowsUploaded >= shape.rows) {
+            tex.levelOffset += shape.rowBytes * shape.rows;
+            tex.rowsUploaded = 0;
+            if (++tex.level >= layout.levels) {
+                tex.level = 0;
+                ++tex.layer;
+            }
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (tex.layer >= layout.layers) {
+        finishUpload(tex);
+    }
+}
+
+void TextureStreamer::finishUpload(StreamedTexture& tex) {
+    const StreamedLayout& layout = tex.layout;
+
+    const GLenum target = layout.target();
+    glState.bindTextureForEdit(target, tex.pendingTexture);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (layout.levels > 1) {
+        glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, layout.levels - 1);
+    } else if (mipmapGeneration != MipmapGeneration::Compute ||
+               !generateMipmapsCompute(tex.pendingTexture, target, layout.width, layout.height, layout.layers, layout.srgbLayers)) {
+        glState.bindTextureForEdit(target, tex.pendingTexture);
+        glGenerateMipmap(target);
+    }
+
+    // Swap the placeholder out only now, so nothing ever samples a half-streamed texture.
+    glState.deleteTexture(tex.texture);
+    tex.texture = tex.pendingTexture;
+    tex.pendingTexture = 0;
+    tex.resident = true;
+
+    // Deletion is deferred by the driver until the queued transfers have consumed the buffer.
+    glDeleteBuffers(1, &tex.pbo);
+    tex.pbo = 0;
+
+    std::cout << "✅ Streamed texture: " << tex.name << "\n";
+    std::cout << "   → Dimensions: " << layout.width << "x" << layout.height;
+    if (layout.array) {
+        std::cout << " × " << layout.layers << " layers";
+    }
+    std::cout << "\n";
+    if (layout.compressedFormat) {
+        std::cout << "   → Format: " << (compressedBlockBytes(layout.compressedFormat) == 8 ? "BC1" : "BC7")
+                  << ", " << layout.levels << " levels, " << layout.bytes / 1024 << " KiB\n";
+    } else {
+        std::cout << "   → Channels: " << layout.channels << "\n";
+    }
+    std::cout << "   → Path: " << (tex.persistent ? "persistently mapped PBO" : "mapped PBO") << "\n";
+    std::cout << "   → Resident after: " << millisecondsSinceStartup() << " ms\n";
+}
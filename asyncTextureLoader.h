@@ -0,0 +1,95 @@
+#ifndef ASYNCTEXTURELOADER_H
+#define ASYNCTEXTURELOADER_H
+#include <GL/glew.h>
+#include "imageDecode.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Both startup metrics (first frame, fully loaded) are measured from static initialisation.
+inline const std::chrono::steady_clock::time_point startupTime = std::chrono::steady_clock::now();
+
+inline double millisecondsSinceStartup() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupTime).count();
+}
+
+struct StreamedLayout {
+    /*
+     * What the worker writes into the pixel buffer. Raw texels are a single level per layer
+     * that gets mipmapped on the GPU; compressed blocks carry each layer's whole mip chain.
+     * Layers are stored one after the other, each `layerBytes()` long.
+     */
+
+    int width = 0, height = 0, channels = 0;
+    int layers = 1;
+    bool array = false;             // GL_TEXTURE_2D_ARRAY (even with a single layer) instead of GL_TEXTURE_2D
+    GLenum compressedFormat = 0;    // GL_COMPRESSED_* for block data, 0 for raw texels
+    int levels = 1;
+    size_t bytes = 0;               // Size of the pixel buffer to map for the worker
+    uint32_t srgbLayers = 0;        // Layers holding sRGB color, filtered in linear light when mipmapped
+
+    [[nodiscard]] GLenum target() const { return array ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D; }
+    [[nodiscard]] size_t layerBytes() const { return bytes / layers; }
+};
+
+// Fills `dst` on a worker thread. It may settle `layout` (e.g. the block format) before returning.
+using DecodeInto = std::function<bool(unsigned char* dst, size_t capacity, StreamedLayout& layout)>;
+
+struct StreamedTexture {
+    /*
+     * A texture that is shown as a 1×1 placeholder color until its pixels
+     * have been decoded off-thread and streamed to the GPU.
+     */
+
+    std::string name;
+    GLuint texture = 0;             // Placeholder until resident, then the real texture
+    GLuint pendingTexture = 0;      // Receives the rows while they are being streamed
+    bool resident = false;
+
+    StreamedLayout layout;
+
+    GLuint pbo = 0;                 // Decode target; the worker writes straight into its mapping
+    unsigned char* mapped = nullptr;
+    bool persistent = false;        // Persistently mapped (GL_ARB_buffer_storage) or unmapped once decoded
+
+    std::future<bool> job;
+    int layer = 0;                  // Layer, level and row (block row for compressed data) the upload has reached
+    int level = 0;
+    int rowsUploaded = 0;
+    size_t levelOffset = 0;
+};
+
+class TextureStreamer {
+    public:
+        explicit TextureStreamer(size_t bytesPerFrame = 1 << 20);
+        ~TextureStreamer();
+
+        // Creates the placeholder texture (one RGBA color per layer) and a mapped PBO of `layout.bytes`, then starts `decode` on a worker thread.
+        StreamedTexture& load(const std::string& name, const unsigned char* placeholderRGBA, const StreamedLayout& layout, DecodeInto decode);
+
+        // Uploads at most `bytesPerFrame` of decoded rows from the PBOs. Call once per frame on the GL thread.
+        void pump();
+
+        [[nodiscard]] bool allResident() const;
+
+        // Waits for the workers and drops the PBOs they write into; call while the GL context is still current.
+        void shutdown();
+
+    private:
+        static constexpr size_t decodeHeadroom = imageDecodeHeadroom;
+
+        std::vector<std::unique_ptr<StreamedTexture>> textures;
+        size_t bytesPerFrame;
+        bool reportedResident = false;
+
+        void beginUpload(StreamedTexture& tex, bool decoded);
+        void uploadRows(StreamedTexture& tex, size_t& budget);
+        void finishUpload(StreamedTexture& tex);
+};
+
+#endif //ASYNCTEXTURELOADER_H
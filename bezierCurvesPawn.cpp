@@ -86,8 +86,6 @@ void generatePawnMesh(
             vAdjusted = (v - controlPoint) / (1.0f - controlPoint); // map [0.0575, 1.0] → [0, 1]
         }
 
-        float texID = 0.0f; // Always use texture1
-
         for (int j = 0; j <= radialDivisions; ++j) {
             float u = static_cast<float>(j) / static_cast<float>(radialDivisions);
             float theta = 2.0f * static_cast<float>(M_PI) * u;
@@ -119,8 +117,8 @@ void generatePawnMesh(
             vert.y = y;
             vert.z = z;
             vert.u = u;
-            vert.v = vAdjusted;
-            vert.texID = texID;
+            vert.v = 1.0f - vAdjusted;  // The marble is decoded top-down (no CPU flip), so flip v instead
+            vert.layer = 0.0f;    // Remapped into the marble's atlas page and region by the caller
             vert.nx = normal.x;
             vert.ny = normal.y;
             vert.nz = normal.z;
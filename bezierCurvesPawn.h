@@ -4,15 +4,24 @@
 
 #ifndef BEZIERCURVESPAWN_H
 #define BEZIERCURVESPAWN_H
+#include <cstdint>
 #include <iostream>
 
 struct Vertex {
     float x, y, z;
     float u, v;
-    float texID;
+    float layer;    // Material texture array layer: the atlas page holding the vertex's material
     float nx, ny, nz;
 };
 
+// --vertex-format=quantized: what a Vertex is uploaded as; see Pawn::uploadQuantizedVertices().
+struct QuantizedVertex {
+    int16_t position[3];    // Normalized to the mesh bounds
+    uint16_t layer;
+    uint16_t uv[2];         // Normalized
+    uint32_t normal;        // GL_INT_2_10_10_10_REV, normalized
+};
+
 void generatePawnMesh(
     /*
      * Create vertices and indices for the Pawn
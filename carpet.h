@@ -1,807 +0,0 @@
-#pragma once
-
-inline unsigned char carpet_1_png[] = {
-  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
-  0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10,
-  0x08, 0x06, 0x00, 0x00, 0x00, 0x1f, 0xf3, 0xff, 0x61, 0x00, 0x00, 0x01,
-  0x84, 0x69, 0x43, 0x43, 0x50, 0x49, 0x43, 0x43, 0x20, 0x70, 0x72, 0x6f,
-  0x66, 0x69, 0x6c, 0x65, 0x00, 0x00, 0x28, 0x91, 0x7d, 0x91, 0x3d, 0x48,
-  0xc3, 0x40, 0x1c, 0xc5, 0x5f, 0x53, 0xa5, 0x22, 0xad, 0x0e, 0x76, 0x10,
-  0x75, 0x08, 0x58, 0x9d, 0x2c, 0x88, 0x8a, 0x38, 0x6a, 0x15, 0x8a, 0x50,
-  0x21, 0xd4, 0x0a, 0xad, 0x3a, 0x98, 0x5c, 0xfa, 0x05, 0x4d, 0x1a, 0x92,
-  0x14, 0x17, 0x47, 0xc1, 0xb5, 0xe0, 0xe0, 0xc7, 0x62, 0xd5, 0xc1, 0xc5,
-  0x59, 0x57, 0x07, 0x57, 0x41, 0x10, 0xfc, 0x00, 0x71, 0x17, 0x9c, 0x14,
-  0x5d, 0xa4, 0xc4, 0xff, 0x25, 0x85, 0x16, 0xb1, 0x1e, 0x1c, 0xf7, 0xe3,
-  0xdd, 0xbd, 0xc7, 0xdd, 0x3b, 0x40, 0xa8, 0x95, 0x98, 0x66, 0x75, 0x8c,
-  0x03, 0x9a, 0x6e, 0x9b, 0xc9, 0x78, 0x4c, 0x4c, 0x67, 0x56, 0xc5, 0xc0,
-  0x2b, 0x02, 0xe8, 0x41, 0x08, 0xc3, 0x18, 0x94, 0x99, 0x65, 0xcc, 0x49,
-  0x52, 0x02, 0x6d, 0xc7, 0xd7, 0x3d, 0x7c, 0x7c, 0xbd, 0x8b, 0xf2, 0xac,
-  0xf6, 0xe7, 0xfe, 0x1c, 0x21, 0x35, 0x6b, 0x31, 0xc0, 0x27, 0x12, 0xcf,
-  0x32, 0xc3, 0xb4, 0x89, 0x37, 0x88, 0xa7, 0x37, 0x6d, 0x83, 0xf3, 0x3e,
-  0x71, 0x98, 0x15, 0x64, 0x95, 0xf8, 0x9c, 0x78, 0xcc, 0xa4, 0x0b, 0x12,
-  0x3f, 0x72, 0x5d, 0xf1, 0xf8, 0x8d, 0x73, 0xde, 0x65, 0x81, 0x67, 0x86,
-  0xcd, 0x54, 0x72, 0x9e, 0x38, 0x4c, 0x2c, 0xe6, 0x5b, 0x58, 0x69, 0x61,
-  0x56, 0x30, 0x35, 0xe2, 0x29, 0xe2, 0x88, 0xaa, 0xe9, 0x94, 0x2f, 0xa4,
-  0x3d, 0x56, 0x39, 0x6f, 0x71, 0xd6, 0x4a, 0x15, 0xd6, 0xb8, 0x27, 0x7f,
-  0x61, 0x30, 0xab, 0xaf, 0x2c, 0x73, 0x9d, 0xe6, 0x10, 0xe2, 0x58, 0xc4,
-  0x12, 0x24, 0x88, 0x50, 0x50, 0x41, 0x11, 0x25, 0xd8, 0x88, 0xd2, 0xaa,
-  0x93, 0x62, 0x21, 0x49, 0xfb, 0xb1, 0x36, 0xfe, 0x01, 0xd7, 0x2f, 0x91,
-  0x4b, 0x21, 0x57, 0x11, 0x8c, 0x1c, 0x0b, 0x28, 0x43, 0x83, 0xec, 0xfa,
-  0xc1, 0xff, 0xe0, 0x77, 0xb7, 0x56, 0x6e, 0x72, 0xc2, 0x4b, 0x0a, 0xc6,
-  0x80, 0xce, 0x17, 0xc7, 0xf9, 0x18, 0x01, 0x02, 0xbb, 0x40, 0xbd, 0xea,
-  0x38, 0xdf, 0xc7, 0x8e, 0x53, 0x3f, 0x01, 0xfc, 0xcf, 0xc0, 0x95, 0xde,
-  0xf4, 0x97, 0x6b, 0xc0, 0xcc, 0x27, 0xe9, 0xd5, 0xa6, 0x16, 0x39, 0x02,
-  0x7a, 0xb7, 0x81, 0x8b, 0xeb, 0xa6, 0xa6, 0xec, 0x01, 0x97, 0x3b, 0x40,
-  0xff, 0x93, 0x21, 0x9b, 0xb2, 0x2b, 0xf9, 0x69, 0x0a, 0xb9, 0x1c, 0xf0,
-  0x7e, 0x46, 0xdf, 0x94, 0x01, 0xfa, 0x6e, 0x81, 0xee, 0x35, 0xaf, 0xb7,
-  0xc6, 0x3e, 0x4e, 0x1f, 0x80, 0x14, 0x75, 0x95, 0xb8, 0x01, 0x0e, 0x0e,
-  0x81, 0xd1, 0x3c, 0x65, 0xaf, 0xb7, 0x79, 0x77, 0x57, 0x6b, 0x6f, 0xff,
-  0x9e, 0x69, 0xf4, 0xf7, 0x03, 0x66, 0xa8, 0x72, 0xa2, 0x1b, 0x5b, 0x30,
-  0x3f, 0x00, 0x00, 0x00, 0x06, 0x62, 0x4b, 0x47, 0x44, 0x00, 0x3f, 0x00,
-  0xef, 0x00, 0x20, 0x43, 0xe2, 0x23, 0x7d, 0x00, 0x00, 0x00, 0x09, 0x70,
-  0x48, 0x59, 0x73, 0x00, 0x00, 0x0b, 0x13, 0x00, 0x00, 0x0b, 0x13, 0x01,
-  0x00, 0x9a, 0x9c, 0x18, 0x00, 0x00, 0x00, 0x07, 0x74, 0x49, 0x4d, 0x45,
-  0x07, 0xe9, 0x07, 0x0e, 0x0e, 0x16, 0x20, 0x82, 0x08, 0xf3, 0xdc, 0x00,
-  0x00, 0x00, 0x19, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65,
-  0x6e, 0x74, 0x00, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x64, 0x20, 0x77,
-  0x69, 0x74, 0x68, 0x20, 0x47, 0x49, 0x4d, 0x50, 0x57, 0x81, 0x0e, 0x17,
-  0x00, 0x00, 0x01, 0xcc, 0x49, 0x44, 0x41, 0x54, 0x38, 0xcb, 0x3d, 0x93,
-  0x5d, 0x92, 0xd4, 0x30, 0x0c, 0x84, 0xbf, 0x96, 0xe2, 0xcc, 0x4c, 0xb6,
-  0x38, 0x04, 0x1c, 0x8d, 0x2a, 0x8e, 0xbd, 0x70, 0x04, 0x96, 0x82, 0x65,
-  0x92, 0x58, 0xb6, 0x78, 0x50, 0x96, 0xa7, 0xd8, 0x65, 0x77, 0xd4, 0x7f,
-  0x16, 0x5f, 0xbf, 0x25, 0x39, 0xe0, 0x76, 0x83, 0x7d, 0x87, 0xa3, 0xc3,
-  0xeb, 0x2b, 0x48, 0xd0, 0x1a, 0x7c, 0xf9, 0x0c, 0x8f, 0x3b, 0xcc, 0x01,
-  0x4b, 0x43, 0x6f, 0x3f, 0xc9, 0xef, 0x3f, 0xe0, 0x0c, 0xb8, 0xdf, 0x30,
-  0xfd, 0x7a, 0x83, 0x39, 0x0b, 0xb0, 0x6d, 0xb0, 0x3d, 0x0a, 0x98, 0x09,
-  0xc7, 0x09, 0x31, 0x00, 0xe0, 0xec, 0x90, 0x49, 0xce, 0x09, 0x18, 0x20,
-  0x40, 0x58, 0x9e, 0x3b, 0x44, 0x87, 0x08, 0xe8, 0x1d, 0x9d, 0x67, 0xfd,
-  0xf0, 0x3c, 0xe1, 0x3c, 0xe0, 0xfd, 0x77, 0xed, 0xcd, 0x60, 0x4e, 0xe4,
-  0x0d, 0xd6, 0xb5, 0xf0, 0xee, 0x18, 0x13, 0x94, 0x82, 0x1e, 0x60, 0x46,
-  0xe6, 0x04, 0x12, 0x00, 0xb9, 0x17, 0xab, 0x76, 0x81, 0x80, 0xfc, 0xfb,
-  0x44, 0xbd, 0xd7, 0x79, 0x04, 0x46, 0x5b, 0xc8, 0xed, 0x01, 0x8b, 0x81,
-  0x7b, 0x5d, 0xdc, 0xb6, 0xba, 0xfc, 0xf2, 0x02, 0xe6, 0x28, 0xe2, 0xbf,
-  0x4c, 0xdd, 0x57, 0xb2, 0xd8, 0x93, 0x23, 0x30, 0xcd, 0x89, 0x32, 0x61,
-  0x26, 0x8c, 0x01, 0xcf, 0x67, 0xad, 0xa5, 0x62, 0xe0, 0x4e, 0xf6, 0x28,
-  0x49, 0x40, 0x4a, 0x20, 0x2b, 0x49, 0xf7, 0x07, 0xc6, 0xba, 0x92, 0x99,
-  0x35, 0x9d, 0xd2, 0x45, 0x3f, 0xcb, 0xb0, 0xfd, 0x89, 0xf6, 0x03, 0x46,
-  0xa2, 0x08, 0x34, 0x46, 0x9d, 0xfb, 0x65, 0xa2, 0x84, 0xe5, 0xba, 0x96,
-  0x66, 0x33, 0xd8, 0x9f, 0xf0, 0xe7, 0xbd, 0x1c, 0x07, 0x34, 0x81, 0xd1,
-  0x41, 0x83, 0x5c, 0x96, 0x9a, 0x3e, 0x27, 0x6a, 0xed, 0x32, 0xd4, 0x59,
-  0xc0, 0x60, 0xbd, 0xa1, 0x84, 0xb4, 0x06, 0x8f, 0x47, 0x45, 0x4a, 0x92,
-  0x0c, 0x94, 0x40, 0x5b, 0x11, 0x95, 0xac, 0xf6, 0x9d, 0x3c, 0x3b, 0xe4,
-  0x24, 0x23, 0x30, 0x5d, 0xe6, 0xa5, 0x81, 0x46, 0xaf, 0xc2, 0x48, 0xe5,
-  0x83, 0x2d, 0xe4, 0xfd, 0x0e, 0xde, 0xc8, 0x14, 0x8a, 0x4e, 0xce, 0x44,
-  0x73, 0x40, 0x0c, 0x34, 0x02, 0x63, 0xf1, 0x02, 0x01, 0xe9, 0x1f, 0x49,
-  0x34, 0xb0, 0x62, 0x81, 0x2f, 0x90, 0x03, 0xce, 0x83, 0x44, 0xd0, 0x8f,
-  0x32, 0x55, 0x22, 0x25, 0xac, 0x78, 0x19, 0xc8, 0x61, 0xbd, 0x15, 0x20,
-  0x46, 0x75, 0xa3, 0x35, 0x38, 0x9f, 0x55, 0xb4, 0x39, 0x4a, 0x19, 0xaa,
-  0xd2, 0xc9, 0x20, 0x06, 0x96, 0x31, 0xaa, 0x44, 0x73, 0x54, 0x54, 0x73,
-  0x54, 0xc6, 0x2e, 0xe4, 0x0b, 0x92, 0xd7, 0xb9, 0x3b, 0xb9, 0xae, 0xe8,
-  0xd3, 0x0b, 0xe4, 0x04, 0x17, 0x8c, 0xc0, 0xe8, 0x1d, 0x45, 0xaf, 0xc2,
-  0x7c, 0x94, 0xe8, 0x65, 0x03, 0x2b, 0x40, 0x26, 0x17, 0xc3, 0xaa, 0x72,
-  0xce, 0x89, 0xa2, 0xe2, 0x94, 0xc4, 0x82, 0x54, 0x93, 0x5b, 0xab, 0x3e,
-  0x1c, 0x07, 0xec, 0x47, 0x75, 0x62, 0x8e, 0xca, 0xfc, 0x76, 0xa5, 0x00,
-  0x60, 0x0e, 0x8b, 0xd7, 0xa6, 0xad, 0x98, 0xcc, 0xea, 0x61, 0xcc, 0x59,
-  0xce, 0xef, 0x7b, 0xf5, 0x60, 0x5c, 0x8f, 0x0b, 0x55, 0x47, 0xdc, 0xeb,
-  0x2b, 0x91, 0x66, 0x10, 0x41, 0xb6, 0x85, 0x7f, 0x45, 0x1c, 0x0c, 0x7c,
-  0x40, 0x19, 0x97, 0xd6, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
-  0xae, 0x42, 0x60, 0x82
-};
-inline unsigned int carpet_1_png_len = 1012;
-
-inline unsigned char carpet_2_png[] = {
-  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
-  0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10,
-  0x08, 0x06, 0x00, 0x00, 0x00, 0x1f, 0xf3, 0xff, 0x61, 0x00, 0x00, 0x01,
-  0x84, 0x69, 0x43, 0x43, 0x50, 0x49, 0x43, 0x43, 0x20, 0x70, 0x72, 0x6f,
-  0x66, 0x69, 0x6c, 0x65, 0x00, 0x00, 0x28, 0x91, 0x7d, 0x91, 0x3d, 0x48,
-  0xc3, 0x40, 0x1c, 0xc5, 0x5f, 0x53, 0xa5, 0x22, 0xad, 0x0e, 0x76, 0x10,
-  0x75, 0x08, 0x58, 0x9d, 0x2c, 0x88, 0x8a, 0x38, 0x6a, 0x15, 0x8a, 0x50,
-  0x21, 0xd4, 0x0a, 0xad, 0x3a, 0x98, 0x5c, 0xfa, 0x05, 0x4d, 0x1a, 0x92,
-  0x14, 0x17, 0x47, 0xc1, 0xb5, 0xe0, 0xe0, 0xc7, 0x62, 0xd5, 0xc1, 0xc5,
-  0x59, 0x57, 0x07, 0x57, 0x41, 0x10, 0xfc, 0x00, 0x71, 0x17, 0x9c, 0x14,
-  0x5d, 0xa4, 0xc4, 0xff, 0x25, 0x85, 0x16, 0xb1, 0x1e, 0x1c, 0xf7, 0xe3,
-  0xdd, 0xbd, 0xc7, 0xdd, 0x3b, 0x40, 0xa8, 0x95, 0x98, 0x66, 0x75, 0x8c,
-  0x03, 0x9a, 0x6e, 0x9b, 0xc9, 0x78, 0x4c, 0x4c, 0x67, 0x56, 0xc5, 0xc0,
-  0x2b, 0x02, 0xe8, 0x41, 0x08, 0xc3, 0x18, 0x94, 0x99, 0x65, 0xcc, 0x49,
-  0x52, 0x02, 0x6d, 0xc7, 0xd7, 0x3d, 0x7c, 0x7c, 0xbd, 0x8b, 0xf2, 0xac,
-  0xf6, 0xe7, 0xfe, 0x1c, 0x21, 0x35, 0x6b, 0x31, 0xc0, 0x27, 0x12, 0xcf,
-  0x32, 0xc3, 0xb4, 0x89, 0x37, 0x88, 0xa7, 0x37, 0x6d, 0x83, 0xf3, 0x3e,
-  0x71, 0x98, 0x15, 0x64, 0x95, 0xf8, 0x9c, 0x78, 0xcc, 0xa4, 0x0b, 0x12,
-  0x3f, 0x72, 0x5d, 0xf1, 0xf8, 0x8d, 0x73, 0xde, 0x65, 0x81, 0x67, 0x86,
-  0xcd, 0x54, 0x72, 0x9e, 0x38, 0x4c, 0x2c, 0xe6, 0x5b, 0x58, 0x69, 0x61,
-  0x56, 0x30, 0x35, 0xe2, 0x29, 0xe2, 0x88, 0xaa, 0xe9, 0x94, 0x2f, 0xa4,
-  0x3d, 0x56, 0x39, 0x6f, 0x71, 0xd6, 0x4a, 0x15, 0xd6, 0xb8, 0x27, 0x7f,
-  0x61, 0x30, 0xab, 0xaf, 0x2c, 0x73, 0x9d, 0xe6, 0x10, 0xe2, 0x58, 0xc4,
-  0x12, 0x24, 0x88, 0x50, 0x50, 0x41, 0x11, 0x25, 0xd8, 0x88, 0xd2, 0xaa,
-  0x93, 0x62, 0x21, 0x49, 0xfb, 0xb1, 0x36, 0xfe, 0x01, 0xd7, 0x2f, 0x91,
-  0x4b, 0x21, 0x57, 0x11, 0x8c, 0x1c, 0x0b, 0x28, 0x43, 0x83, 0xec, 0xfa,
-  0xc1, 0xff, 0xe0, 0x77, 0xb7, 0x56, 0x6e, 0x72, 0xc2, 0x4b, 0x0a, 0xc6,
-  0x80, 0xce, 0x17, 0xc7, 0xf9, 0x18, 0x01, 0x02, 0xbb, 0x40, 0xbd, 0xea,
-  0x38, 0xdf, 0xc7, 0x8e, 0x53, 0x3f, 0x01, 0xfc, 0xcf, 0xc0, 0x95, 0xde,
-  0xf4, 0x97, 0x6b, 0xc0, 0xcc, 0x27, 0xe9, 0xd5, 0xa6, 0x16, 0x39, 0x02,
-  0x7a, 0xb7, 0x81, 0x8b, 0xeb, 0xa6, 0xa6, 0xec, 0x01, 0x97, 0x3b, 0x40,
-  0xff, 0x93, 0x21, 0x9b, 0xb2, 0x2b, 0xf9, 0x69, 0x0a, 0xb9, 0x1c, 0xf0,
-  0x7e, 0x46, 0xdf, 0x94, 0x01, 0xfa, 0x6e, 0x81, 0xee, 0x35, 0xaf, 0xb7,
-  0xc6, 0x3e, 0x4e, 0x1f, 0x80, 0x14, 0x75, 0x95, 0xb8, 0x01, 0x0e, 0x0e,
-  0x81, 0xd1, 0x3c, 0x65, 0xaf, 0xb7, 0x79, 0x77, 0x57, 0x6b, 0x6f, 0xff,
-  0x9e, 0x69, 0xf4, 0xf7, 0x03, 0x66, 0xa8, 0x72, 0xa2, 0x1b, 0x5b, 0x30,
-  0x3f, 0x00, 0x00, 0x00, 0x06, 0x62, 0x4b, 0x47, 0x44, 0x00, 0x3f, 0x00,
-  0xef, 0x00, 0x20, 0x43, 0xe2, 0x23, 0x7d, 0x00, 0x00, 0x00, 0x09, 0x70,
-  0x48, 0x59, 0x73, 0x00, 0x00, 0x0b, 0x13, 0x00, 0x00, 0x0b, 0x13, 0x01,
-  0x00, 0x9a, 0x9c, 0x18, 0x00, 0x00, 0x00, 0x07, 0x74, 0x49, 0x4d, 0x45,
-  0x07, 0xe9, 0x07, 0x0e, 0x0e, 0x30, 0x39, 0x25, 0xbd, 0xd8, 0x38, 0x00,
-  0x00, 0x00, 0x19, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65,
-  0x6e, 0x74, 0x00, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x64, 0x20, 0x77,
-  0x69, 0x74, 0x68, 0x20, 0x47, 0x49, 0x4d, 0x50, 0x57, 0x81, 0x0e, 0x17,
-  0x00, 0x00, 0x01, 0xe6, 0x49, 0x44, 0x41, 0x54, 0x38, 0xcb, 0x45, 0x92,
-  0xd9, 0x6e, 0x15, 0x31, 0x0c, 0x86, 0x3f, 0x3b, 0x99, 0xb5, 0x74, 0x01,
-  0x51, 0x40, 0xad, 0x78, 0x39, 0x24, 0x1e, 0xbb, 0xbc, 0x02, 0x5d, 0xce,
-  0x9c, 0x59, 0xe2, 0xc4, 0x5c, 0x78, 0x24, 0xae, 0x22, 0xc7, 0xc9, 0xbf,
-  0xd9, 0xc2, 0xaf, 0xdf, 0x8e, 0x57, 0x18, 0x06, 0xd8, 0x36, 0xd8, 0x0b,
-  0xbc, 0xbc, 0x80, 0x08, 0x7c, 0xba, 0x81, 0xe7, 0x67, 0x98, 0x46, 0x68,
-  0x15, 0x52, 0x46, 0xde, 0xdf, 0xf0, 0x97, 0x3f, 0x70, 0x18, 0x8c, 0x03,
-  0x2a, 0x6f, 0xaf, 0xd0, 0x5a, 0x7c, 0x98, 0x67, 0x98, 0x27, 0xe8, 0xba,
-  0xa8, 0xaf, 0x2b, 0x58, 0x05, 0x80, 0xda, 0xc0, 0x1d, 0x6f, 0x0d, 0x50,
-  0x40, 0x00, 0x41, 0xfd, 0xd8, 0xc0, 0x0a, 0x98, 0x41, 0x29, 0x88, 0x95,
-  0x00, 0x34, 0x83, 0xa7, 0x6f, 0xf0, 0xfc, 0x1d, 0xba, 0x1c, 0xf5, 0xbe,
-  0x83, 0xe4, 0x20, 0x12, 0x20, 0x25, 0x32, 0x0d, 0xc4, 0x05, 0xb7, 0x0a,
-  0xcb, 0x05, 0x7f, 0x7d, 0x03, 0x95, 0x90, 0x9d, 0x52, 0xb0, 0x67, 0x05,
-  0xd5, 0x00, 0xae, 0x15, 0x59, 0x16, 0x1c, 0x10, 0x33, 0x94, 0x2e, 0xe3,
-  0x37, 0x33, 0x74, 0x09, 0x3e, 0x2e, 0x70, 0x1c, 0xa0, 0x09, 0x96, 0x2b,
-  0x7c, 0x7e, 0x08, 0x45, 0x08, 0xb8, 0x87, 0xb5, 0x7d, 0xc3, 0x55, 0xe2,
-  0xaa, 0x1a, 0x59, 0xda, 0xe9, 0x4d, 0x53, 0x84, 0xb8, 0xae, 0x01, 0xf0,
-  0xe3, 0x11, 0xf6, 0x03, 0xef, 0xba, 0xd3, 0x2f, 0x61, 0xe3, 0xba, 0x82,
-  0x13, 0x8a, 0xc6, 0x89, 0x4c, 0xdf, 0xe3, 0xee, 0xd0, 0x1c, 0x4a, 0x89,
-  0xf3, 0x76, 0x82, 0x2f, 0x0f, 0xd0, 0x77, 0xc1, 0x4c, 0x03, 0x3c, 0x3e,
-  0x66, 0x0d, 0x3c, 0x07, 0x44, 0x50, 0xef, 0xfb, 0xb3, 0xf2, 0xf0, 0x08,
-  0xc8, 0x34, 0xc1, 0x38, 0x82, 0x2a, 0xda, 0x14, 0x3c, 0x21, 0xa2, 0x01,
-  0xf6, 0xb1, 0xc4, 0x73, 0x40, 0x52, 0x42, 0x41, 0xa1, 0xeb, 0x23, 0xb8,
-  0x1c, 0xe3, 0xf3, 0x63, 0x0b, 0x40, 0x01, 0x7f, 0xfd, 0x0b, 0xa5, 0xe0,
-  0xc3, 0x10, 0x16, 0x20, 0x88, 0xbc, 0xe1, 0x66, 0x64, 0xc9, 0x8a, 0xa7,
-  0x04, 0xfd, 0x1c, 0x4d, 0x95, 0xb0, 0xb2, 0xed, 0xd0, 0x3c, 0x32, 0x48,
-  0x19, 0xae, 0x4b, 0x04, 0x6b, 0x16, 0x16, 0xac, 0x22, 0xd5, 0xc8, 0xe4,
-  0x14, 0x5b, 0x36, 0xf6, 0x31, 0x3a, 0x01, 0x5c, 0xe0, 0x63, 0x85, 0x4f,
-  0x0e, 0xe3, 0x0c, 0xde, 0x22, 0xbc, 0xd6, 0x4e, 0xf6, 0xe0, 0x72, 0x11,
-  0x32, 0xee, 0x20, 0x8a, 0xd4, 0x8a, 0xab, 0x46, 0xb3, 0x39, 0xf2, 0xfe,
-  0x8e, 0xa7, 0x33, 0xbf, 0x69, 0x0a, 0x55, 0xc7, 0x11, 0xc1, 0xae, 0x1b,
-  0x88, 0x82, 0x55, 0xd4, 0xad, 0x82, 0x55, 0xfc, 0x72, 0x89, 0x87, 0xf3,
-  0x04, 0x77, 0xf7, 0xf8, 0xba, 0x21, 0xa2, 0xc8, 0x38, 0x40, 0x39, 0x65,
-  0x3f, 0xdc, 0x23, 0x3f, 0x9f, 0xa0, 0x1a, 0x24, 0x81, 0x6a, 0x28, 0xa5,
-  0x20, 0xd5, 0x62, 0xd6, 0x77, 0xb7, 0xf0, 0xf8, 0x15, 0xca, 0x0e, 0xb5,
-  0xe2, 0xb5, 0xe1, 0xb5, 0x05, 0xdb, 0x30, 0x42, 0x3f, 0xe0, 0xb5, 0x22,
-  0x56, 0x21, 0x25, 0x44, 0x04, 0x45, 0x24, 0xa4, 0xd5, 0x1a, 0xa3, 0x4b,
-  0xe9, 0x5c, 0x16, 0x87, 0xcb, 0x02, 0xd6, 0x60, 0xe8, 0x91, 0xbb, 0xdb,
-  0xc8, 0x48, 0x13, 0xe4, 0x14, 0x56, 0xbb, 0x9e, 0x2c, 0xaa, 0xff, 0x77,
-  0xa0, 0x39, 0x5c, 0xaf, 0x70, 0x94, 0x90, 0x59, 0x0a, 0x82, 0x44, 0x36,
-  0x72, 0xae, 0xb3, 0x9c, 0xb5, 0x19, 0x3e, 0x4f, 0xfc, 0x03, 0x6b, 0x86,
-  0x13, 0x15, 0xe0, 0x6e, 0x2e, 0x80, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
-  0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
-};
-inline unsigned int carpet_2_png_len = 1038;
-
-
-const char logo_svg[] = R"SVGDELIM(<?xml version="1.0" encoding="UTF-8" standalone="no"?>
-<!DOCTYPE svg PUBLIC "-//W3C//DTD SVG 20010904//EN" "http://www.w3.org/TR/2001/REC-SVG-20010904/DTD/svg10.dtd">
-
-<svg xmlns="http://www.w3.org/2000/svg"
-     width="114.638mm" height="120.988mm"
-     viewBox="0 0 325 343">
-
-    <defs>
-        <linearGradient id="dark-blue" x1="0%" y1="0%" x2="100%" y2="100%">
-            <stop offset="0%" style="stop-color:#00ffc0;stop-opacity:1" />
-            <stop offset="100%" style="stop-color:#aa11ff;stop-opacity:1" />
-        </linearGradient>
-    </defs>
-
-    <defs>
-        <linearGradient id="light-blue" x1="0%" y1="0%" x2="100%" y2="100%">
-            <stop offset="0%" style="stop-color:#00ffff;stop-opacity:1" />
-            <stop offset="100%" style="stop-color:#aa11ff;stop-opacity:1" />
-        </linearGradient>
-    </defs>
-
-    <defs>
-        <linearGradient id="light-green" x1="0%" y1="0%" x2="100%" y2="100%">
-            <stop offset="0%" style="stop-color:#22dd00;stop-opacity:1" />
-            <stop offset="100%" style="stop-color:#ff0033;stop-opacity:1" />
-        </linearGradient>
-    </defs>
-
-    <defs>
-        <linearGradient id="dark-green" x1="0%" y1="0%" x2="100%" y2="100%">
-            <stop offset="0%" style="stop-color:#003300;stop-opacity:1" />
-            <stop offset="100%" style="stop-color:#00ee00;stop-opacity:1" />
-        </linearGradient>
-    </defs>
-
-    <path id="Selection"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 26.00,0.00
-           C 30.49,3.81 32.73,8.28 36.15,13.00
-             36.15,13.00 53.61,36.00 53.61,36.00
-             71.09,57.32 91.07,76.84 114.00,92.25
-             137.04,107.74 162.66,119.03 188.00,130.14
-             197.11,134.14 217.66,140.67 224.00,147.00
-             200.85,141.72 171.68,129.62 150.00,119.69
-             145.42,117.60 132.71,110.76 128.10,113.06
-             125.75,114.23 124.35,116.87 123.00,119.00
-             85.25,108.83 39.00,79.25 27.44,40.00
-             24.03,28.41 24.43,11.93 26.00,0.00 Z" />
-
-    <path id="Selection"
-          fill="url(#light-blue)" stroke="black" stroke-width="1"
-          d="M 133.00,2.00
-           C 133.00,2.00 135.00,2.00 135.00,2.00
-             144.03,28.03 157.24,57.10 172.51,80.00
-             177.33,87.21 182.70,94.38 188.29,101.00
-             192.37,105.82 197.29,110.24 200.00,116.00
-             189.38,112.87 188.72,106.25 181.00,100.63
-             177.80,98.32 175.91,98.11 172.00,94.79
-             157.48,82.47 141.17,59.72 133.86,42.00
-             128.32,28.56 125.52,15.21 133.00,2.00 Z" />
-    <path id="middle back feather"
-          fill="url(#light-blue)" stroke="black" stroke-width="1"
-          d="M 116.00,26.00
-           C 127.18,39.29 133.11,57.22 152.28,79.00
-             155.96,83.18 164.72,91.97 169.00,95.33
-             173.05,98.52 178.48,100.40 181.00,105.00
-             171.16,107.58 159.50,98.25 152.00,92.63
-             136.05,80.66 115.25,61.52 115.00,40.00
-             114.91,32.12 115.45,32.79 116.00,26.00 Z" />
-    <path id="Star"
-          fill="url(#light-blue)" stroke="black" stroke-width="1"
-          d="M 222.00,42.00
-           C 222.00,42.00 224.00,42.00 224.00,42.00
-             224.78,46.68 225.54,47.43 230.00,49.00
-             227.06,53.47 225.06,51.65 224.00,58.00
-             224.00,58.00 215.00,50.00 215.00,50.00
-             219.61,47.04 220.46,47.76 222.00,42.00 Z" />
-    <path id="Star"
-          fill="url(#light-blue)" stroke="black" stroke-width="1"
-          d="M 94.00,44.00
-           C 94.00,44.00 102.00,50.00 102.00,50.00
-             102.00,50.00 94.00,56.00 94.00,56.00
-             94.00,56.00 90.00,50.00 90.00,50.00
-             90.00,50.00 94.00,44.00 94.00,44.00 Z" />
-    <path id="Star"
-          fill="url(#light-blue)" stroke="black" stroke-width="1"
-          d="M 202.00,53.00
-           C 202.00,53.00 204.00,53.00 204.00,53.00
-             204.00,53.00 209.00,61.00 209.00,61.00
-             209.00,61.00 202.00,66.00 202.00,66.00
-             202.00,66.00 195.00,59.00 195.00,59.00
-             198.99,56.97 199.64,56.90 202.00,53.00 Z" />
-    <path id="Front feather 2"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 15.00,57.00
-           C 15.00,57.00 31.00,72.71 31.00,72.71
-             48.98,88.49 68.58,102.53 90.00,113.24
-             90.00,113.24 110.00,121.66 110.00,121.66
-             112.28,122.44 117.62,123.71 118.98,125.56
-             120.27,127.32 119.79,131.63 120.00,134.00
-             113.67,135.28 97.85,132.89 91.00,131.75
-             51.36,125.15 15.00,100.80 15.00,57.00 Z" />
-    <path id="back feather 3"
-          fill="url(#light-blue)" stroke="black" stroke-width="1"
-          d="M 107.00,57.00
-           C 111.83,59.63 124.15,73.26 129.00,77.99
-             139.03,87.77 148.18,93.96 160.00,101.19
-             160.00,101.19 180.58,112.79 180.58,112.79
-             182.18,114.34 182.27,115.05 183.00,117.00
-             174.42,115.78 172.51,113.70 165.00,110.42
-             152.95,105.17 141.15,99.02 130.00,92.05
-             124.69,88.73 117.37,84.96 113.64,79.96
-             108.48,73.06 108.41,65.01 107.00,57.00 Z" />
-    <path id="Head"
-          fill="url(#light-blue)" stroke="black" stroke-width="1"
-          d="M 204.00,127.00
-           C 214.15,108.92 233.10,86.79 256.00,88.09
-             264.19,88.56 272.03,90.24 279.00,94.70
-             283.47,97.56 286.71,99.79 290.00,104.00
-             290.00,104.00 275.00,108.00 275.00,108.00
-             272.83,104.47 270.35,101.30 266.00,100.46
-             257.03,98.73 249.86,110.94 261.02,116.43
-             263.33,117.57 265.49,117.77 268.00,118.00
-             263.43,122.83 256.22,123.56 250.00,125.13
-             233.63,129.24 220.65,134.08 204.00,127.00 Z" />
-    <path id="Star"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 4.00,98.00
-           C 4.00,98.00 15.00,108.00 15.00,108.00
-             12.88,108.62 7.59,111.07 6.10,110.91
-             2.97,110.56 0.74,105.83 1.32,103.00
-             1.68,101.23 3.03,99.49 4.00,98.00 Z" />
-    <path id="Eye"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 262.37,105.08
-           C 267.89,103.85 268.73,108.34 266.51,109.77
-             264.38,111.14 259.18,109.31 262.37,105.08 Z" />
-    <path id="Breast"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 125.00,280.00
-           C 138.80,260.90 166.87,257.44 187.00,249.14
-             216.21,237.10 240.60,219.93 249.57,188.00
-             252.59,177.27 252.95,166.06 253.00,155.00
-             253.06,142.54 258.03,132.22 268.00,124.53
-             268.00,124.53 282.00,116.37 282.00,116.37
-             282.00,116.37 295.26,104.38 295.26,104.38
-             297.15,103.77 301.88,103.97 304.00,104.38
-             310.24,104.76 319.95,105.41 325.00,109.00
-             315.22,110.84 306.87,111.99 298.00,116.86
-             284.81,124.12 275.89,133.32 269.49,147.00
-             264.21,158.28 262.95,171.07 259.85,183.00
-             256.14,197.24 249.40,210.88 239.71,222.00
-             225.84,237.92 200.87,251.02 181.00,257.65
-             181.00,257.65 154.00,266.05 154.00,266.05
-             154.00,266.05 125.00,280.00 125.00,280.00 Z" />
-    <path id="Selection"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 302.00,112.00
-           C 302.00,112.00 290.00,114.00 290.00,114.00
-             290.00,114.00 302.00,112.00 302.00,112.00 Z" />
-    <path id="Selection"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 287.00,115.00
-           C 287.00,115.00 286.00,115.00 286.00,115.00
-             286.00,115.00 287.00,116.00 287.00,116.00
-             287.00,116.00 287.00,115.00 287.00,115.00 Z" />
-    <path id="Selection"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 14.00,120.00
-           C 14.00,120.00 22.00,128.00 22.00,128.00
-             14.14,130.85 10.14,128.24 14.00,120.00 Z" />
-    <path id="front feather 3"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 34.00,120.00
-           C 52.74,129.86 77.10,136.11 98.00,139.41
-             98.00,139.41 112.00,140.99 112.00,140.99
-             114.56,141.05 118.22,140.59 120.15,142.60
-             121.78,144.30 122.53,148.69 123.00,151.00
-             123.00,151.00 111.00,153.70 111.00,153.70
-             93.60,156.22 71.98,155.56 56.00,147.74
-             45.44,142.58 35.11,132.18 34.00,120.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 153.00,132.13
-           C 149.84,133.17 146.34,134.71 143.31,132.13
-             139.57,129.23 141.44,122.93 146.02,121.96
-             150.74,120.96 152.03,126.05 153.92,128.91
-             155.47,131.27 162.54,137.75 165.00,138.98
-             171.76,142.35 182.56,137.25 189.00,142.20
-             184.87,143.17 167.85,143.80 164.00,142.20
-             159.67,140.83 155.21,135.93 153.00,132.13 Z" />
-    <path id="Body"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 219.00,159.00
-           C 226.69,154.94 228.39,144.76 233.07,138.22
-             236.83,132.97 252.57,127.47 259.00,128.00
-             254.21,135.16 251.22,137.19 248.75,146.00
-             243.71,163.93 248.48,176.38 241.47,195.00
-             229.56,226.63 194.28,244.87 163.00,252.00
-             168.21,244.79 180.93,235.50 188.00,228.91
-             209.40,208.98 224.51,189.74 219.00,159.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 136.00,139.00
-           C 134.64,139.89 133.63,140.75 132.00,141.24
-             123.35,143.80 121.22,130.71 129.02,129.37
-             130.65,129.09 132.41,129.53 133.69,130.60
-             134.82,131.55 135.32,132.62 135.84,134.02
-             136.03,135.33 135.98,137.60 135.84,139.00
-             138.93,139.00 142.27,138.76 145.00,139.93
-             152.93,143.35 149.48,146.98 162.00,146.84
-             162.00,146.84 185.91,146.84 185.91,146.84
-             189.83,145.66 191.73,141.38 195.90,142.65
-             198.30,143.39 199.56,145.95 201.37,146.98
-             203.71,148.28 206.52,147.44 209.00,146.98
-             209.00,146.98 210.00,150.00 210.00,150.00
-             210.00,150.00 202.00,150.87 202.00,150.87
-             202.00,150.87 194.01,152.55 194.01,152.55
-             194.01,152.55 186.83,150.00 186.83,150.00
-             186.83,150.00 160.00,150.00 160.00,150.00
-             160.00,150.00 152.00,148.98 152.00,148.98
-             152.00,148.98 143.00,142.89 143.00,142.89
-             143.00,142.89 134.00,142.89 134.00,142.89
-             134.00,142.89 136.00,139.00 136.00,139.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 133.00,154.00
-           C 133.00,154.00 162.00,154.00 162.00,154.00
-             162.00,154.00 189.00,155.00 189.00,155.00
-             193.80,155.01 200.07,153.62 203.00,158.00
-             203.00,158.00 173.00,158.00 173.00,158.00
-             173.00,158.00 157.00,157.00 157.00,157.00
-             157.00,157.00 133.00,157.00 133.00,157.00
-             133.00,157.00 133.00,154.00 133.00,154.00 Z" />
-    <path id="Front feather 4"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 67.00,161.00
-           C 67.00,161.00 106.00,159.83 106.00,159.83
-             106.00,159.83 124.90,156.89 124.90,156.89
-             128.38,157.80 130.73,162.96 132.00,166.00
-             124.10,170.50 112.00,175.40 103.00,176.70
-             89.61,178.63 73.61,173.30 67.00,161.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 113.00,202.00
-           C 102.50,205.21 95.44,203.80 85.00,203.09
-             78.91,202.67 76.50,204.09 71.00,200.29
-             63.07,194.83 56.15,187.30 49.00,180.83
-             46.93,178.96 42.32,173.91 40.00,173.15
-             37.44,172.32 35.49,174.12 33.00,174.40
-             27.01,175.05 22.35,169.83 23.24,164.00
-             24.00,159.05 28.18,156.50 33.00,157.24
-             39.95,158.31 37.96,163.37 44.06,170.00
-             44.06,170.00 73.00,196.43 73.00,196.43
-             77.87,199.89 82.35,198.94 88.00,199.00
-             88.00,199.00 101.00,200.00 101.00,200.00
-             106.20,199.99 107.87,198.78 113.00,200.00
-             113.00,200.00 113.00,202.00 113.00,202.00 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 30.22,162.66
-           C 25.41,166.27 30.09,169.76 32.70,168.60
-             34.95,167.60 36.36,162.17 30.22,162.66 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 201.00,164.00
-           C 206.01,159.64 211.44,160.98 211.63,166.00
-             211.75,169.24 209.18,170.45 208.15,174.04
-             208.15,174.04 208.15,192.00 208.15,192.00
-             207.98,202.73 207.11,197.95 194.00,211.00
-             194.00,211.00 160.00,245.00 160.00,245.00
-             155.34,249.63 147.12,258.20 141.00,260.00
-             144.18,253.28 148.79,250.88 153.72,245.83
-             153.72,245.83 171.99,227.99 171.99,227.99
-             171.99,227.99 187.17,212.28 187.17,212.28
-             190.12,209.41 203.38,198.30 204.40,195.83
-             205.12,194.08 205.00,190.93 205.00,189.00
-             205.01,182.96 204.56,176.91 206.00,171.00
-             198.39,166.48 202.43,165.02 192.00,165.00
-             192.00,165.00 159.00,165.00 159.00,165.00
-             152.38,165.00 145.46,164.43 139.00,166.00
-             139.00,166.00 138.00,162.00 138.00,162.00
-             138.00,162.00 183.00,162.00 183.00,162.00
-             188.44,162.00 196.54,160.72 201.00,164.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 145.00,169.00
-           C 154.41,170.69 165.35,170.02 175.00,170.00
-             182.88,169.98 183.79,168.75 185.98,168.68
-             188.91,168.58 191.45,170.74 190.34,173.79
-             188.29,179.44 183.56,173.14 176.00,173.00
-             176.00,173.00 145.00,173.00 145.00,173.00
-             145.00,173.00 145.00,169.00 145.00,169.00 Z" />
-    <path id="Front feather 5"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 98.00,183.00
-           C 114.52,182.23 123.69,173.80 137.00,170.00
-             137.00,170.00 145.00,179.00 145.00,179.00
-             135.03,188.49 123.93,194.10 110.00,190.52
-             104.68,189.16 100.68,188.06 98.00,183.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 270.00,185.00
-           C 274.05,185.00 292.38,185.46 294.86,184.40
-             299.07,182.60 299.80,172.19 309.00,174.45
-             317.45,176.52 318.25,188.23 309.96,191.91
-             302.30,195.31 299.37,187.07 293.99,188.65
-             289.76,189.90 284.55,197.52 280.00,200.02
-             276.72,201.82 269.00,201.00 265.00,201.00
-             265.00,201.00 265.00,199.00 265.00,199.00
-             277.60,199.00 276.58,197.42 286.00,188.00
-             286.00,188.00 270.00,188.00 270.00,188.00
-             270.00,188.00 270.00,185.00 270.00,185.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 116.00,210.00
-           C 110.81,211.47 105.36,210.99 100.00,211.00
-             100.00,211.00 76.00,212.00 76.00,212.00
-             63.04,211.97 66.65,207.84 59.00,204.02
-             56.39,202.72 52.88,203.02 50.00,203.00
-             39.89,202.94 39.36,199.97 32.04,193.43
-             30.71,192.24 27.40,188.93 25.87,188.48
-             22.00,187.35 18.76,194.49 12.04,191.95
-             4.00,188.92 5.03,177.87 13.02,175.51
-             19.90,173.48 22.19,178.55 26.21,182.58
-             28.71,185.09 41.60,196.78 44.00,197.98
-             46.01,198.98 47.83,198.96 50.00,199.00
-             53.72,199.06 57.58,198.56 61.00,200.31
-             64.71,202.22 67.34,206.06 71.00,207.40
-             73.62,208.36 87.33,208.04 91.00,208.00
-             98.83,207.90 109.18,204.89 116.00,210.00 Z" />
-    <path id="Tail 3"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 58.00,333.00
-           C 59.57,328.90 61.20,326.69 63.40,323.00
-             63.40,323.00 68.63,314.00 68.63,314.00
-             73.49,307.24 83.86,298.98 90.00,292.99
-             90.00,292.99 116.00,268.17 116.00,268.17
-             116.00,268.17 140.00,247.83 140.00,247.83
-             140.00,247.83 159.00,229.09 159.00,229.09
-             159.00,229.09 185.00,204.00 185.00,204.00
-             188.45,200.55 194.17,195.99 194.85,191.00
-             195.66,185.12 188.85,178.93 196.05,176.66
-             199.05,175.71 201.81,177.82 201.55,180.98
-             201.35,183.32 199.37,184.98 198.58,187.17
-             196.98,191.62 199.76,194.51 194.85,199.91
-             194.85,199.91 185.01,209.00 185.01,209.00
-             185.01,209.00 151.00,242.96 151.00,242.96
-             144.07,249.59 136.59,255.55 130.46,263.00
-             116.90,279.48 97.62,312.93 82.00,323.96
-             74.71,329.10 66.78,331.76 58.00,333.00 Z" />
-    <path id="Selection"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 172.11,178.08
-           C 180.07,176.52 181.83,185.99 176.77,188.97
-             172.98,191.21 168.45,188.28 168.45,184.00
-             168.45,180.97 169.98,179.74 172.11,178.08 Z" />
-    <path id="Selection"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 15.06,179.58
-           C 8.41,182.36 13.00,187.72 16.73,186.34
-             19.33,185.38 20.96,180.26 15.06,179.58 Z" />
-    <path id="Selection"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 306.13,179.74
-           C 300.68,183.17 304.49,187.97 307.79,186.60
-             310.59,185.44 312.29,180.01 306.13,179.74 Z" />
-    <path id="Tail feather 2a"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 183.90,179.00
-           C 183.90,179.00 186.96,179.00 186.96,179.00
-             186.96,179.00 186.96,196.83 186.96,196.83
-             185.33,200.56 176.26,208.22 173.00,211.17
-             164.54,218.82 148.69,236.63 139.00,241.00
-             141.83,234.97 146.33,231.49 151.00,226.96
-             151.00,226.96 170.00,208.72 170.00,208.72
-             172.96,206.10 182.53,197.17 183.90,194.00
-             184.55,192.16 184.00,181.82 183.90,179.00 Z" />
-    <path id="Front feather 6"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 130.00,196.00
-           C 130.00,196.00 144.00,186.34 144.00,186.34
-             145.66,185.05 149.11,181.94 151.00,181.48
-             154.64,180.61 162.25,187.15 160.83,191.03
-             160.13,192.96 157.61,195.23 156.00,196.44
-             147.98,202.48 138.78,201.68 130.00,198.00
-             130.00,198.00 130.00,196.00 130.00,196.00 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 176.00,181.00
-           C 170.90,181.88 170.53,184.42 175.00,187.00
-             175.00,187.00 176.00,181.00 176.00,181.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 73.00,189.00
-           C 73.00,189.00 90.00,188.00 90.00,188.00
-             90.00,188.00 90.00,191.00 90.00,191.00
-             84.72,191.00 77.34,192.20 73.00,189.00 Z" />
-    <path id="Tail feathe 1"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 2.00,260.00
-           C 2.00,260.00 46.00,254.25 46.00,254.25
-             74.34,249.52 101.38,244.58 127.00,230.69
-             136.80,225.38 145.39,219.47 154.00,212.39
-             158.68,208.53 162.48,203.61 168.00,201.00
-             162.90,210.07 151.36,221.65 143.00,227.85
-             143.00,227.85 120.00,242.68 120.00,242.68
-             120.00,242.68 102.00,253.42 102.00,253.42
-             102.00,253.42 87.00,261.24 87.00,261.24
-             61.85,273.61 22.25,288.27 2.00,260.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 119.00,219.00
-           C 119.00,219.00 99.00,220.00 99.00,220.00
-             99.00,220.00 80.00,220.00 80.00,220.00
-             80.00,220.00 41.00,216.15 41.00,216.15
-             41.00,216.15 29.00,216.15 29.00,216.15
-             25.37,217.09 23.58,219.31 20.00,219.73
-             13.14,220.54 7.75,213.76 10.35,208.02
-             12.67,202.91 19.13,200.71 23.89,203.85
-             27.32,206.11 27.63,209.35 30.27,210.98
-             32.28,212.21 35.68,212.00 38.00,212.08
-             38.00,212.08 49.00,212.08 49.00,212.08
-             49.00,212.08 74.00,215.00 74.00,215.00
-             74.00,215.00 99.00,216.00 99.00,216.00
-             99.00,216.00 119.00,215.00 119.00,215.00
-             119.00,215.00 119.00,219.00 119.00,219.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 260.00,211.00
-           C 260.00,211.00 288.00,211.00 288.00,211.00
-             290.18,210.98 292.81,211.12 294.74,209.98
-             297.38,208.42 301.11,200.44 308.91,203.85
-             316.54,207.19 315.47,220.16 306.00,221.52
-             299.05,222.51 298.99,216.19 289.00,216.00
-             289.00,216.00 259.00,216.00 259.00,216.00
-             259.00,216.00 260.00,211.00 260.00,211.00 Z" />
-    <path id="Front feather dot"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 127.00,205.96
-           C 134.10,206.23 133.34,212.97 128.94,214.34
-             124.56,215.71 118.79,209.89 127.00,205.96 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 18.13,207.82
-           C 13.40,210.69 16.64,214.26 19.05,213.97
-             21.97,213.63 24.69,208.32 18.13,207.82 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 304.21,208.74
-           C 299.15,212.09 302.88,216.07 305.79,215.26
-             308.53,214.50 310.31,209.01 304.21,208.74 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 108.00,229.00
-           C 104.72,234.81 102.41,232.02 92.00,232.00
-             92.00,232.00 72.00,232.00 72.00,232.00
-             72.00,232.00 51.00,233.00 51.00,233.00
-             48.63,233.00 45.33,232.79 43.26,234.02
-             39.97,235.98 39.13,241.36 32.00,240.87
-             22.60,240.23 21.12,229.35 29.04,225.18
-             35.83,221.60 36.98,228.07 48.00,228.00
-             48.00,228.00 75.00,228.00 75.00,228.00
-             82.78,228.00 101.54,227.16 108.00,229.00 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 32.95,228.86
-           C 28.10,230.30 28.80,234.37 31.31,235.34
-             35.14,236.83 39.53,230.86 32.95,228.86 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 237.00,237.00
-           C 237.00,237.00 259.00,237.00 259.00,237.00
-             270.04,236.79 266.98,228.63 275.00,228.44
-             281.40,228.28 285.18,235.33 283.49,240.98
-             281.39,247.98 270.04,250.09 267.00,240.00
-             263.33,240.00 256.25,239.29 253.39,241.60
-             249.18,244.99 244.62,261.07 238.90,263.40
-             237.29,264.06 234.74,263.99 233.00,264.00
-             224.81,264.05 201.53,264.85 195.00,263.00
-             195.00,263.00 195.00,261.00 195.00,261.00
-             195.00,261.00 232.00,260.00 232.00,260.00
-             232.00,260.00 237.79,258.98 237.79,258.98
-             237.79,258.98 249.00,241.00 249.00,241.00
-             249.00,241.00 237.00,240.00 237.00,240.00
-             237.00,240.00 237.00,237.00 237.00,237.00 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 275.00,234.03
-           C 268.82,236.88 273.42,241.64 276.70,240.34
-             279.09,239.40 280.03,235.13 275.00,234.03 Z" />
-    <path id="Tail feather 2b"
-          fill="url(#dark-blue)" stroke="black" stroke-width="1"
-          d="M 130.00,243.00
-           C 130.76,247.30 126.88,249.15 124.09,252.04
-             124.09,252.04 106.00,270.42 106.00,270.42
-             89.18,285.03 68.87,309.43 44.00,307.91
-             36.41,307.44 30.75,303.91 24.00,301.00
-             24.00,301.00 24.00,299.00 24.00,299.00
-             24.00,299.00 61.00,279.26 61.00,279.26
-             61.00,279.26 81.00,270.03 81.00,270.03
-             81.00,270.03 130.00,243.00 130.00,243.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 296.10,259.85
-           C 299.54,258.88 302.76,258.56 305.88,260.74
-             311.21,264.43 311.29,273.38 305.88,276.91
-             297.68,282.25 295.44,274.18 286.00,274.00
-             286.00,274.00 176.00,274.00 176.00,274.00
-             176.00,274.00 161.00,275.00 161.00,275.00
-             158.85,275.02 151.01,275.27 149.55,274.43
-             147.54,273.36 148.06,271.14 149.55,269.99
-             151.27,268.76 154.97,269.00 157.00,269.00
-             157.00,269.00 191.00,269.00 191.00,269.00
-             191.00,269.00 208.00,268.00 208.00,268.00
-             208.00,268.00 243.00,268.00 243.00,268.00
-             243.00,268.00 283.00,268.00 283.00,268.00
-             292.40,267.82 289.61,263.96 296.10,259.85 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 300.04,264.74
-           C 292.87,267.07 297.67,274.23 301.86,272.60
-             305.20,271.30 305.94,266.24 300.04,264.74 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 134.00,282.00
-           C 135.95,280.28 138.21,277.85 141.00,277.74
-             145.11,277.57 144.19,280.93 154.00,281.00
-             154.00,281.00 215.00,281.00 215.00,281.00
-             215.00,281.00 233.00,282.00 233.00,282.00
-             233.00,282.00 250.00,281.00 250.00,281.00
-             256.72,280.88 263.86,276.35 268.26,282.23
-             269.49,283.87 269.96,285.99 269.53,288.00
-             267.91,295.54 256.02,298.59 255.00,286.00
-             255.00,286.00 239.00,286.00 239.00,286.00
-             239.00,286.00 223.00,285.16 223.00,285.16
-             223.00,285.16 153.00,285.16 153.00,285.16
-             150.90,285.01 149.06,284.96 147.00,285.16
-             141.14,286.99 139.14,290.29 134.00,282.00 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 261.00,283.00
-           C 260.61,284.00 260.08,284.74 260.00,285.94
-             259.57,292.06 268.33,288.00 263.54,284.13
-             262.60,283.37 261.88,283.34 261.00,283.00 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 252.00,297.09
-           C 252.00,297.09 147.00,297.09 147.00,297.09
-             147.00,297.09 142.00,297.09 142.00,297.09
-             137.94,298.03 135.31,300.78 131.23,297.84
-             130.25,297.13 129.24,296.06 129.05,294.82
-             128.60,291.85 132.12,288.69 134.96,288.82
-             137.21,288.93 139.17,291.16 141.17,292.07
-             143.62,293.19 146.38,292.99 149.00,292.90
-             149.00,292.90 170.00,292.90 170.00,292.90
-             170.00,292.90 182.00,292.90 182.00,292.90
-             182.00,292.90 190.00,292.90 190.00,292.90
-             190.00,292.90 252.00,292.90 252.00,292.90
-             252.00,292.90 252.00,297.09 252.00,297.09 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 135.00,314.00
-           C 131.99,312.10 127.09,309.42 129.08,305.06
-             129.81,303.45 131.37,302.20 133.02,301.88
-             133.02,301.88 146.00,301.88 146.00,301.88
-             146.00,301.88 282.00,301.88 282.00,301.88
-             292.63,301.80 288.47,296.14 295.04,293.60
-             301.71,291.02 308.78,297.04 307.57,304.00
-             306.56,309.77 300.47,313.18 295.00,311.26
-             295.00,311.26 288.00,307.58 288.00,307.58
-             285.93,306.89 283.19,307.00 281.00,307.00
-             281.00,307.00 240.00,307.00 240.00,307.00
-             240.00,307.00 223.00,308.00 223.00,308.00
-             223.00,308.00 174.00,308.00 174.00,308.00
-             174.00,308.00 153.00,308.00 153.00,308.00
-             150.31,308.00 144.28,307.75 142.00,308.60
-             139.06,309.70 137.77,311.61 136.00,314.00
-             136.00,314.00 185.00,315.00 185.00,315.00
-             185.00,315.00 248.00,315.00 248.00,315.00
-             251.34,315.01 254.04,314.73 257.00,316.60
-             262.16,319.86 267.93,328.72 274.00,329.99
-             285.10,332.32 286.40,319.18 295.96,323.02
-             305.83,326.98 302.41,343.48 291.00,341.76
-             285.76,340.97 284.33,337.00 280.83,335.60
-             276.54,333.88 272.42,336.75 267.00,332.69
-             257.78,325.77 259.08,320.03 246.00,320.00
-             246.00,320.00 150.00,320.00 150.00,320.00
-             146.74,320.06 144.93,320.05 142.32,322.30
-             139.84,324.44 138.04,328.60 134.04,327.72
-             129.84,326.79 125.76,319.47 135.00,314.00 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 298.90,299.25
-           C 293.95,300.36 294.92,304.41 297.30,305.35
-             300.66,306.67 304.26,301.78 298.90,299.25 Z" />
-    <path id="Print dot"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 237.04,326.76
-           C 247.78,326.45 248.17,340.28 239.96,342.26
-             231.64,344.26 226.36,331.14 237.04,326.76 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 292.05,328.74
-           C 285.25,331.09 290.28,337.46 293.69,335.83
-             296.06,334.70 297.06,330.15 292.05,328.74 Z" />
-    <path id="Print path"
-          fill="url(#dark-green)" stroke="black" stroke-width="1"
-          d="M 143.00,331.00
-           C 143.00,331.00 160.00,330.01 160.00,330.01
-             160.00,330.01 173.00,331.00 173.00,331.00
-             173.00,331.00 200.00,331.00 200.00,331.00
-             197.47,334.25 194.88,333.95 191.00,334.00
-             191.00,334.00 143.00,334.00 143.00,334.00
-             143.00,334.00 143.00,331.00 143.00,331.00 Z" />
-    <path id="Dot"
-          fill="red" stroke="black" stroke-width="1"
-          d="M 238.04,332.91
-           C 234.46,335.30 237.36,337.36 238.79,337.09
-             240.18,336.83 242.01,333.89 238.04,332.91 Z" />
-</svg>
-)SVGDELIM";
-
-const unsigned int logo_svg_len = sizeof(logo_svg) - 1;
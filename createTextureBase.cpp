@@ -1,22 +1,40 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
-#include "carpet.h"
+#include <vector>
+#include "assetPack.h"
+#include "createTextureBase.h"
+#include "scratchArena.h"
 
 #include "stb_image.h"
 
+// NanoSVG has no allocator hooks, so point its malloc/realloc/free calls at the scratch arena.
+// Its system headers are included first so the macros only ever see NanoSVG's own calls.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define malloc(size) scratchMalloc(size)
+#define realloc(ptr, size) scratchRealloc(ptr, size)
+#define free(ptr) scratchFree(ptr)
 #define NANOSVG_IMPLEMENTATION
 #define NANOSVG_ALL_COLOR_KEYWORDS
 #include "nanosvg.h"
 #define NANOSVGRAST_IMPLEMENTATION
 #include "nanosvgrast.h"
+#undef malloc
+#undef realloc
+#undef free
 
 const int tileCountX = 120, tileCountY = 68;
 
-unsigned char* rasterizeSVG(const char* logo_svg, int targetWidth, int targetHeight) {
-    char* mutableSvg = new char[logo_svg_len + 1];
-    memcpy(mutableSvg, logo_svg, logo_svg_len);
-    mutableSvg[logo_svg_len] = '\0';  // Ensure null-termination
+unsigned char* rasterizeSVG(const Asset& logo, int targetWidth, int targetHeight) {
+    // NanoSVG parses in place, so hand it a null-terminated copy of the (read-only) asset.
+    ScratchVector<char> mutableSvg(logo.data, logo.data + logo.size);
+    mutableSvg.push_back('\0');
 
-    NSVGimage* svg = nsvgParse(mutableSvg, "px", 96);
+    NSVGimage* svg = nsvgParse(mutableSvg.data(), "px", 96);
 
     if (!svg) {
         std::cerr << "❌ Failed to parse SVG\n";
@@ -24,8 +42,14 @@ unsigned char* rasterizeSVG(const char* logo_svg, int targetWidth, int targetHei
     }
 
     NSVGrasterizer* rast = nsvgCreateRasterizer();
-    unsigned char* svgPixels = new unsigned char[targetWidth * targetHeight * 4];  // RGBA
-    std::memset(svgPixels, 0, targetWidth * targetHeight * 4);  // Clear buffer
+    auto* svgPixels = static_cast<unsigned char*>(scratchMalloc(static_cast<size_t>(targetWidth) * targetHeight * 4));  // RGBA
+    if (!svgPixels) {
+        std::cerr << "❌ Out of memory for the SVG raster\n";
+        nsvgDelete(svg);
+        nsvgDeleteRasterizer(rast);
+        return nullptr;
+    }
+    std::memset(svgPixels, 0, static_cast<size_t>(targetWidth) * targetHeight * 4);  // Clear buffer
 
     float scale = std::min(targetWidth / svg->width, targetHeight / svg->height);
     float offsetX = (targetWidth - svg->width * scale) / 2.0f;
@@ -38,97 +62,158 @@ unsigned char* rasterizeSVG(const char* logo_svg, int targetWidth, int targetHei
     return svgPixels;
 }
 
-unsigned char* stitchTextures(int& outWidth, int& outHeight, int& channels) {
-    srand(static_cast<unsigned>(time(nullptr)));  // Seed RNG
-
+struct BaseCrop {
+    int fullWidth, fullHeight;  // The stitched tiles as if composed in full
+    int x0, y0;                 // Top-left of the crop in full texture coordinates
     int width, height;
-    unsigned char* smallTex1 = stbi_load_from_memory(carpet_1_png, static_cast<signed>(carpet_1_png_len), &width, &height, &channels, 0);
-    unsigned char* smallTex2 = stbi_load_from_memory(carpet_2_png, static_cast<signed>(carpet_2_png_len), &width, &height, &channels, 0);
+};
+
+static bool baseCrop(int tileWidth, int tileHeight, BaseCrop& crop) {
+    crop.fullWidth = tileCountX * tileWidth;
+    crop.fullHeight = tileCountY * tileHeight;
+    crop.width = static_cast<int>(std::ceil(2.0f * baseCropHalfExtent * static_cast<float>(crop.fullWidth)));
+    crop.height = static_cast<int>(std::ceil(2.0f * baseCropHalfExtent * static_cast<float>(crop.fullHeight)));
+    crop.x0 = (crop.fullWidth - crop.width) / 2;
+    crop.y0 = (crop.fullHeight - crop.height) / 2;
+    return crop.width > 0 && crop.height > 0;
+}
 
-    if (!smallTex1 || !smallTex2) {
-        std::cerr << "❌ Failed to load small textures: " << stbi_failure_reason() << "\n";
-        return nullptr;
+bool baseTextureSize(int& width, int& height, int& channels) {
+    int tileWidth, tileHeight, tileChannels;
+    Asset carpet1 = loadAsset("carpet_1.png");
+    if (!carpet1 || !stbi_info_from_memory(carpet1.data, static_cast<int>(carpet1.size), &tileWidth, &tileHeight, &tileChannels)) {
+        std::cerr << "❌ Failed to read carpet tile header: " << stbi_failure_reason() << "\n";
+        return false;
     }
 
-    outWidth = tileCountX * width;
-    outHeight = tileCountY * height;
-    size_t imageSize = outWidth * outHeight * channels;
-    unsigned char* bigTex = new unsigned char[imageSize];
-
-    for (int ty = 0; ty < tileCountY; ++ty) {
-        for (int tx = 0; tx < tileCountX; ++tx) {
-            bool useTex2 = (rand() % 10) > 1;  // ~80% chance
-            unsigned char* srcTex = useTex2 ? smallTex1 : smallTex2;
-
-            for (int y = 0; y < height; ++y) {
-                memcpy(
-                    bigTex + ((ty * height + y) * outWidth + tx * width) * channels,
-                    srcTex + y * width * channels,
-                    width * channels
-                );
-            }
-        }
+    BaseCrop crop{};
+    if (!baseCrop(tileWidth, tileHeight, crop)) {
+        return false;
     }
 
-    stbi_image_free(smallTex1);
-    stbi_image_free(smallTex2);
-    return bigTex;
+    width = crop.width;
+    height = crop.height;
+    channels = 4;
+    return true;
+}
+
+void stitchTextures(unsigned char* row, int y, const BaseCrop& crop, const std::vector<bool>& useTex2,
+                    const unsigned char* smallTex1, const unsigned char* smallTex2, int width, int height) {
+    int fullY = crop.y0 + y;
+    int ty = fullY / height;
+    int tileRow = fullY % height;
+
+    // Copy the part of every tile that overlaps [x0, x0 + crop.width) of the full row.
+    for (int x = 0; x < crop.width;) {
+        int fullX = crop.x0 + x;
+        int tx = fullX / width;
+        int tileX = fullX % width;
+        int span = std::min(width - tileX, crop.width - x);
+
+        const unsigned char* srcTex = useTex2[ty * tileCountX + tx] ? smallTex1 : smallTex2;
+        memcpy(row + x * 4, srcTex + (tileRow * width + tileX) * 4, span * 4);
+        x += span;
+    }
 }
 
-void blendCenter(unsigned char* dst, int dstW, int dstH, unsigned char* src, int srcW, int srcH) {
-    int startX = (dstW - srcW) / 2;
-    int startY = (dstH - srcH) / 2;
-
-    for (int y = 0; y < srcH; ++y) {
-        for (int x = 0; x < srcW; ++x) {
-            int dstIdx = ((startY + y) * dstW + (startX + x)) * 4;
-            int srcIdx = (y * srcW + x) * 4;
-
-            float alpha = src[srcIdx + 3] / 255.0f;
-            for (int c = 0; c < 3; ++c) {
-                dst[dstIdx + c] = static_cast<unsigned char>(
-                    src[srcIdx + c] * alpha + dst[dstIdx + c] * (1.0f - alpha)
-                );
-            }
-            dst[dstIdx + 3] = 255; // Full alpha
+void blendCenter(unsigned char* row, int y, const BaseCrop& crop, const unsigned char* src, int srcW, int srcH) {
+    int startX = (crop.fullWidth - srcW) / 2 - crop.x0;
+    int startY = (crop.fullHeight - srcH) / 2 - crop.y0;
+
+    int sy = y - startY;
+    if (sy < 0 || sy >= srcH) {
+        return;
+    }
+
+    for (int x = std::max(0, -startX); x < srcW && startX + x < crop.width; ++x) {
+        int dstIdx = (startX + x) * 4;
+        int srcIdx = (sy * srcW + x) * 4;
+
+        float alpha = src[srcIdx + 3] / 255.0f;
+        for (int c = 0; c < 3; ++c) {
+            row[dstIdx + c] = static_cast<unsigned char>(
+                src[srcIdx + c] * alpha + row[dstIdx + c] * (1.0f - alpha)
+            );
         }
+        row[dstIdx + 3] = 255; // Full alpha
     }
 }
 
-void createTextureBase(unsigned char*& bigTex, int& width, int& height, int& channels) {
-    /*
-     * Usage:
-     *     unsigned char* pixelBuf = nullptr;
-     *     int width = 0, height = 0, channels = 0;
-     *     createTexture(pixelBuf, width, height, channels);
-     *     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixelBuf);
-     */
+bool loadBaseSources(BaseSources& sources) {
+    Asset carpet1 = loadAsset("carpet_1.png");
+    Asset carpet2 = loadAsset("carpet_2.png");
+    Asset logo = loadAsset("logo.svg");
+    if (!carpet1 || !carpet2 || !logo) {
+        return false;
+    }
 
-    bigTex = stitchTextures(width, height, channels);
+    // Only the carpet tiles are flipped on load, and only on this thread; the marble is decoded
+    // top-down by imageDecode and flipped in its UVs.
+    int tileChannels;
+    stbi_set_flip_vertically_on_load_thread(true);
+    sources.carpets[0] = stbi_load_from_memory(carpet1.data, static_cast<int>(carpet1.size), &sources.tileWidth, &sources.tileHeight, &tileChannels, 4);
+    sources.carpets[1] = stbi_load_from_memory(carpet2.data, static_cast<int>(carpet2.size), &sources.tileWidth, &sources.tileHeight, &tileChannels, 4);
+    stbi_set_flip_vertically_on_load_thread(false);
 
-    if (!bigTex) {
-        return;
+    BaseCrop crop{};
+    if (!sources.carpets[0] || !sources.carpets[1] || !baseCrop(sources.tileWidth, sources.tileHeight, crop)) {
+        std::cerr << "❌ Failed to load small textures: " << stbi_failure_reason() << "\n";
+        releaseBaseSources(sources);
+        return false;
     }
 
-    // Rasterize SVG to fit a portion of the stitched texture
-    int svgWidth = width / 2;
-    int svgHeight = height / 2;
+    // Rasterize SVG to fit a portion of the (uncropped) stitched texture
+    sources.logoWidth = crop.fullWidth / 2;
+    sources.logoHeight = crop.fullHeight / 2;
+    sources.logo = rasterizeSVG(logo, sources.logoWidth, sources.logoHeight);
+    if (!sources.logo) {
+        releaseBaseSources(sources);
+        return false;
+    }
+    return true;
+}
 
-    // Copy logo_svg (assumed const char*) to mutable buffer for NanoSVG
-    char* svgCopy = new char[strlen(logo_svg) + 1];
-    strcpy(svgCopy, logo_svg);
+void releaseBaseSources(BaseSources& sources) {
+    stbi_image_free(sources.carpets[0]);
+    stbi_image_free(sources.carpets[1]);
+    scratchFree(sources.logo);
+    sources = {};
+}
 
-    unsigned char* svgBuffer = rasterizeSVG(svgCopy, svgWidth, svgHeight);
-    delete[] svgCopy;
+bool createTextureBase(unsigned char* dst, int width, int height, const BaseSources& sources) {
+    /*
+     * Usage:
+     *     int width = 0, height = 0, channels = 0;
+     *     baseTextureSize(width, height, channels);
+     *     BaseSources sources;
+     *     loadBaseSources(sources);
+     *     createTextureBase(dst, width, height, sources);     // `dst` holds width * height * 4 bytes
+     *     releaseBaseSources(sources);
+     *
+     * Only the bounding square of the visible disc is composed (see baseCropHalfExtent); tile
+     * placement and the logo are laid out as if the full stitched texture were built.
+     * The texture is composed one row at a time in a small cached scratch row and then written
+     * to `dst` exactly once, so `dst` may be write-combined memory that must never be read back.
+     */
 
-    if (!svgBuffer) {
-        delete[] bigTex;
-        bigTex = nullptr;
-        return;
+    srand(static_cast<unsigned>(time(nullptr)));  // Seed RNG
+
+    BaseCrop crop{};
+    if (!baseCrop(sources.tileWidth, sources.tileHeight, crop) || width != crop.width || height != crop.height) {
+        std::cerr << "❌ Base sources do not match a " << width << "x" << height << " base\n";
+        return false;
     }
 
-    // Blend the SVG into the center
-    blendCenter(bigTex, width, height, svgBuffer, svgWidth, svgHeight);
+    std::vector<bool> useTex2(tileCountX * tileCountY);
+    for (auto&& tile : useTex2) {
+        tile = (rand() % 10) > 1;  // ~80% chance
+    }
 
-    delete[] svgBuffer;
+    std::vector<unsigned char> row(static_cast<size_t>(width) * 4);
+    for (int y = 0; y < height; ++y) {
+        stitchTextures(row.data(), y, crop, useTex2, sources.carpets[0], sources.carpets[1], sources.tileWidth, sources.tileHeight);
+        blendCenter(row.data(), y, crop, sources.logo, sources.logoWidth, sources.logoHeight);
+        memcpy(dst + static_cast<size_t>(y) * width * 4, row.data(), row.size());
+    }
+    return true;
 }
@@ -5,6 +5,35 @@
 #ifndef CREATETEXTURE_H
 #define CREATETEXTURE_H
 
-void createTextureBase(unsigned char*& bigTex, int& width, int& height, int& channels);
+struct Asset;
+
+// Object-space radius of the visible disc (the full base quad spans one unit); the base shader masks out everything beyond it.
+constexpr float baseDiscRadius = 0.298f;
+constexpr float baseDiscEdgeWidth = 0.001f;
+
+// Only the disc's bounding square, plus a small margin for the rim and filtering, is composed.
+constexpr float baseCropHalfExtent = 0.302f;
+
+struct BaseSources {
+    /*
+     * What the base is composed from, RGBA8: the two carpet tiles, flipped on load, and the logo
+     * rasterized at the stitched texture's scale. The atlas takes its copies of the tiles from here too.
+     */
+
+    unsigned char* carpets[2] = { nullptr, nullptr };
+    int tileWidth = 0, tileHeight = 0;
+    unsigned char* logo = nullptr;
+    int logoWidth = 0, logoHeight = 0;
+};
+
+// Size of the cropped base texture at the full stitched texture's texel density.
+bool baseTextureSize(int& width, int& height, int& channels);
+// Decode and rasterize the sources (from the thread's scratch arena, if one is open); release them after use.
+bool loadBaseSources(BaseSources& sources);
+void releaseBaseSources(BaseSources& sources);
+bool createTextureBase(unsigned char* dst, int width, int height, const BaseSources& sources);
+
+// RGBA8 raster of the SVG, fit and centered in the target size; free with scratchFree().
+unsigned char* rasterizeSVG(const Asset& logo, int targetWidth, int targetHeight);
 
 #endif //CREATETEXTURE_H
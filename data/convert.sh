@@ -1 +0,0 @@
-xxd -i base.jpg > base_jpg.h
@@ -0,0 +1,481 @@
+#include "dynamicResolution.h"
+#include "programCache.h"
+#include "glState.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+
+// Full-screen triangle from gl_VertexID, no vertex buffer needed; `uv` spans the viewport.
+static const char* const fullScreenVertexShaderSource = R"(
+        #version 330 core
+        out vec2 uv;
+
+        void main() {
+            vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            uv = p;
+            gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+static GLuint beginUpscaleProgram(UpscaleFilter filter, bool fxaa) {
+    std::string fragmentShaderSource = "#version 330 core\n";
+    if (filter == UpscaleFilter::Sharpen) {
+        fragmentShaderSource += "#define SHARPEN\n";
+    }
+    if (fxaa) {
+        fragmentShaderSource += "#define FXAA\n";
+    }
+    fragmentShaderSource += R"(
+        in vec2 uv;
+        out vec4 FragColor;
+
+        uniform sampler2D scene;
+        uniform vec2 renderSize;    // The part of `scene` that was drawn, in texels
+
+        vec3 sceneAt(vec2 texel) {
+            // Clamped half a texel inside the drawn part, so filtering never reaches the stale rest of the target.
+            texel = clamp(texel, vec2(0.5), renderSize - 0.5);
+            return texture(scene, texel / vec2(textureSize(scene, 0))).rgb;
+        }
+
+#ifdef FXAA
+        float luma(vec3 color) {
+            return dot(color, vec3(0.299, 0.587, 0.114));
+        }
+
+        // FXAA without the edge search: blur along the local edge, by up to 8 texels, unless that
+        // leaves the range of the surrounding luma (then the edge was a thin feature: blur less).
+        vec3 fxaa(vec2 texel) {
+            vec3 center = sceneAt(texel);
+            float lumaCenter = luma(center);
+            float lumaA = luma(sceneAt(texel + vec2(-1.0, -1.0)));
+            float lumaB = luma(sceneAt(texel + vec2(1.0, -1.0)));
+            float lumaC = luma(sceneAt(texel + vec2(-1.0, 1.0)));
+            float lumaD = luma(sceneAt(texel + vec2(1.0, 1.0)));
+            float lumaMin = min(lumaCenter, min(min(lumaA, lumaB), min(lumaC, lumaD)));
+            float lumaMax = max(lumaCenter, max(max(lumaA, lumaB), max(lumaC, lumaD)));
+            if (lumaMax - lumaMin < max(0.0312, lumaMax * 0.125)) {
+                return center;
+            }
+
+            vec2 direction = vec2((lumaC + lumaD) - (lumaA + lumaB), (lumaA + lumaC) - (lumaB + lumaD));
+            float reduce = max((lumaA + lumaB + lumaC + lumaD) * 0.25 * 0.125, 1.0 / 128.0);
+            direction = clamp(direction / (min(abs(direction.x), abs(direction.y)) + reduce), vec2(-8.0), vec2(8.0));
+
+            vec3 near = 0.5 * (sceneAt(texel - direction / 6.0) + sceneAt(texel + direction / 6.0));
+            vec3 far = 0.5 * near + 0.25 * (sceneAt(texel - direction * 0.5) + sceneAt(texel + direction * 0.5));
+            float lumaFar = luma(far);
+            return (lumaFar < lumaMin || lumaFar > lumaMax) ? near : far;
+        }
+#endif
+
+        void main() {
+            vec2 texel = uv * renderSize;
+#ifdef FXAA
+            vec3 center = fxaa(texel);
+#else
+            vec3 center = sceneAt(texel);
+#endif
+#ifdef SHARPEN
+            // Unsharp mask over the four neighbours, clamped to their range so edges don't ring.
+            vec3 left = sceneAt(texel - vec2(1.0, 0.0));
+            vec3 right = sceneAt(texel + vec2(1.0, 0.0));
+            vec3 down = sceneAt(texel - vec2(0.0, 1.0));
+            vec3 up = sceneAt(texel + vec2(0.0, 1.0));
+            vec3 low = min(center, min(min(left, right), min(down, up)));
+            vec3 high = max(center, max(max(left, right), max(down, up)));
+            center = clamp(center + 0.5 * (4.0 * center - left - right - down - up), low, high);
+#endif
+            FragColor = vec4(center, 1.0);
+        }
+    )";
+
+    return beginProgram({ { GL_VERTEX_SHADER, fullScreenVertexShaderSource }, { GL_FRAGMENT_SHADER, fragmentShaderSource } });
+}
+
+static GLuint beginTemporalProgram() {
+    const char* fragmentShaderSource = R"(
+        #version 330 core
+        in vec2 uv;
+        out vec4 FragColor;
+
+        uniform sampler2D scene;
+        uniform sampler2D sceneDepth;
+        uniform sampler2D history;
+        uniform vec2 renderSize;
+        uniform mat4 currentToPrevious;
+        uniform float historyWeight;    // 0 while there is no history to blend with
+
+        vec3 colorAt(sampler2D image, vec2 texel) {
+            texel = clamp(texel, vec2(0.5), renderSize - 0.5);
+            return texture(image, texel / vec2(textureSize(image, 0))).rgb;
+        }
+
+        void main() {
+            vec2 texel = uv * renderSize;
+            vec3 current = colorAt(scene, texel);
+
+            // What this frame could blend to around here; history outside it was uncovered or has moved.
+            vec3 low = current;
+            vec3 high = current;
+            for (int y = -1; y <= 1; ++y) {
+                for (int x = -1; x <= 1; ++x) {
+                    vec3 neighbour = colorAt(scene, texel + vec2(x, y));
+                    low = min(low, neighbour);
+                    high = max(high, neighbour);
+                }
+            }
+
+            float depth = texelFetch(sceneDepth, ivec2(texel), 0).r;
+            vec4 previous = currentToPrevious * vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+            vec2 previousUv = previous.xy / previous.w * 0.5 + 0.5;
+            float weight = (previousUv == clamp(previousUv, vec2(0.0), vec2(1.0))) ? historyWeight : 0.0;
+
+            vec3 previousColor = clamp(colorAt(history, previousUv * renderSize), low, high);
+            FragColor = vec4(mix(current, previousColor, weight), 1.0);
+        }
+    )";
+
+    return beginProgram({ { GL_VERTEX_SHADER, fullScreenVertexShaderSource }, { GL_FRAGMENT_SHADER, fragmentShaderSource } });
+}
+
+static float halton(int index, int base) {
+    float fraction = 1.0f;
+    float result = 0.0f;
+    for (; index > 0; index /= base) {
+        fraction /= static_cast<float>(base);
+        result += fraction * static_cast<float>(index % base);
+    }
+    return result;
+}
+
+static std::string antiAliasingName(AntiAliasing antiAliasing, int samples) {
+    switch (antiAliasing) {
+        case AntiAliasing::Msaa:
+            return samples > 1 ? std::to_string(samples) + "× MSAA" : "none (no multisampling available)";
+        case AntiAliasing::Fxaa:
+            return "FXAA";
+        case AntiAliasing::Taa:
+            return "TAA";
+        default:
+            return "none";
+    }
+}
+
+DynamicResolution::DynamicResolution(double budgetMs, float fixedScale, UpscaleFilter filter, AntiAliasing antiAliasing, int samples)
+    : budgetMs(budgetMs), antiAliasing(antiAliasing), dynamic(fixedScale <= 0.0f), currentScale(dynamic ? maxDynamicScale : fixedScale) {
+    for (GLuint (&frameTimestamps)[3] : timestamps) {
+        glGenQueries(3, frameTimestamps);
+    }
+    if (dynamic) {
+        glGenQueries(queryCount, queries);
+        std::cout << "🔍 Dynamic resolution: " << budgetMs << " ms GPU budget for the scene, scale "
+                  << minScale << "–" << maxDynamicScale << "\n";
+    }
+    if (dynamic || currentScale != 1.0f || antiAliasing == AntiAliasing::Fxaa || antiAliasing == AntiAliasing::Taa) {
+        upscaleProgram = beginUpscaleProgram(filter, antiAliasing == AntiAliasing::Fxaa);
+        if (antiAliasing == AntiAliasing::Taa) {
+            temporalProgram = beginTemporalProgram();
+        }
+        glGenVertexArrays(1, &emptyVao);
+
+        GLint maxSamples = 0;
+        glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+        sampleCount = std::min(samples, static_cast<int>(maxSamples));
+    } else {
+        glGetIntegerv(GL_SAMPLES, &sampleCount);
+    }
+}
+
+void DynamicResolution::release() {
+    if (dynamic) {
+        glDeleteQueries(queryCount, queries);
+    }
+    for (GLuint (&frameTimestamps)[3] : timestamps) {
+        glDeleteQueries(3, frameTimestamps);
+    }
+    glDeleteProgram(upscaleProgram);
+    glDeleteProgram(temporalProgram);
+    glDeleteVertexArrays(1, &emptyVao);
+    glState.deleteFramebuffer(fbo);
+    glState.deleteTexture(color);
+    glDeleteRenderbuffers(1, &depth);
+    glState.deleteFramebuffer(msaaFbo);
+    glDeleteRenderbuffers(1, &msaaColor);
+    glDeleteRenderbuffers(1, &msaaDepth);
+    glState.deleteTexture(depthTexture);
+    for (int i = 0; i < 2; ++i) {
+        glState.deleteFramebuffer(historyFbo[i]);
+        glState.deleteTexture(history[i]);
+    }
+}
+
+void DynamicResolution::allocateTarget(int width, int height) {
+    targetWidth = width;
+    targetHeight = height;
+    if (!fbo) {
+        glGenFramebuffers(1, &fbo);
+        glGenRenderbuffers(1, &depth);
+    } else {
+        glState.deleteTexture(color);   // Immutable storage: a new size needs a new texture
+    }
+    color = glState.createTexture(GL_TEXTURE_2D);
+    glState.textureStorage2D(color, GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+    glState.textureParameter(color, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glState.textureParameter(color, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glState.textureParameter(color, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glState.textureParameter(color, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glState.bindFramebuffer(fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    if (antiAliasing == AntiAliasing::Taa) {
+        glState.deleteTexture(depthTexture);
+        depthTexture = glState.createTexture(GL_TEXTURE_2D);
+        glState.textureStorage2D(depthTexture, GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, width, height);
+        glState.textureParameter(depthTexture, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glState.textureParameter(depthTexture, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    } else {
+        glBindRenderbuffer(GL_RENDERBUFFER, depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+    }
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "❌ Render target " << width << "x" << height << " is incomplete\n";
+    }
+
+    if (antiAliasing == AntiAliasing::Taa) {
+        for (int i = 0; i < 2; ++i) {
+            if (!historyFbo[i]) {
+                glGenFramebuffers(1, &historyFbo[i]);
+            }
+            glState.deleteTexture(history[i]);
+            history[i] = glState.createTexture(GL_TEXTURE_2D);
+            glState.textureStorage2D(history[i], GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+            glState.textureParameter(history[i], GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glState.textureParameter(history[i], GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glState.textureParameter(history[i], GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glState.textureParameter(history[i], GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glState.bindFramebuffer(historyFbo[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, history[i], 0);
+        }
+        historyValid = false;
+    }
+
+    if (sampleCount > 1) {
+        if (!msaaFbo) {
+            glGenFramebuffers(1, &msaaFbo);
+            glGenRenderbuffers(1, &msaaColor);
+            glGenRenderbuffers(1, &msaaDepth);
+        }
+        glBindRenderbuffer(GL_RENDERBUFFER, msaaColor);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, sampleCount, GL_RGBA8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, msaaDepth);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, sampleCount, GL_DEPTH_COMPONENT24, width, height);
+
+        glState.bindFramebuffer(msaaFbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, msaaColor);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, msaaDepth);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "❌ " << sampleCount << "x multisampled render target is incomplete, drawing without\n";
+            sampleCount = 0;
+        }
+    }
+}
+
+void DynamicResolution::readTimings() {
+    for (int i = 0; i < queryCount; ++i) {
+        if (!queryPending[i]) {
+            continue;
+        }
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &nanoseconds);
+        queryPending[i] = false;
+
+        const double sample = static_cast<double>(nanoseconds) * 1e-6 / (queryScales[i] * queryScales[i]);
+        msPerScaleSquared = (msPerScaleSquared == 0.0) ? sample : msPerScaleSquared + 0.2 * (sample - msPerScaleSquared);
+    }
+    if (msPerScaleSquared <= 0.0) {
+        return;
+    }
+
+    const float ideal = static_cast<float>(std::sqrt(budgetMs / msPerScaleSquared));
+    const float next = std::clamp(std::floor(ideal / scaleStep) * scaleStep, minScale, maxDynamicScale);
+    if (next < currentScale || next > currentScale + scaleStep) {
+        currentScale = next;
+    }
+}
+
+void DynamicResolution::begin(int windowWidth, int windowHeight) {
+    this->windowWidth = std::max(windowWidth, 1);
+    this->windowHeight = std::max(windowHeight, 1);
+
+    readCosts();
+    glQueryCounter(timestamps[timedFrame][0], GL_TIMESTAMP);
+
+    if (!upscaleProgram) {
+        glState.bindFramebuffer(0);
+        glState.viewport(0, 0, this->windowWidth, this->windowHeight);
+        return;
+    }
+
+    // The target covers the largest scale in use; smaller scales draw into its lower-left corner.
+    const float largestScale = dynamic ? maxDynamicScale : currentScale;
+    const int width = std::max(1, static_cast<int>(std::lround(static_cast<float>(this->windowWidth) * largestScale)));
+    const int height = std::max(1, static_cast<int>(std::lround(static_cast<float>(this->windowHeight) * largestScale)));
+    if (width != targetWidth || height != targetHeight) {
+        allocateTarget(width, height);
+    }
+
+    const int previousWidth = renderWidth, previousHeight = renderHeight;
+    renderWidth = std::max(1, static_cast<int>(std::lround(static_cast<float>(this->windowWidth) * currentScale)));
+    renderHeight = std::max(1, static_cast<int>(std::lround(static_cast<float>(this->windowHeight) * currentScale)));
+    if (renderWidth != previousWidth || renderHeight != previousHeight) {
+        historyValid = false;   // Its texels no longer line up with this frame's
+    }
+    glState.bindFramebuffer(sampleCount > 1 ? msaaFbo : fbo);
+    glState.viewport(0, 0, renderWidth, renderHeight);
+
+    // Skip timing this frame when every query is still in flight, rather than wait on one.
+    if (dynamic && !queryPending[nextQuery]) {
+        activeQuery = nextQuery;
+        nextQuery = (nextQuery + 1) % queryCount;
+        queryScales[activeQuery] = currentScale;
+        glBeginQuery(GL_TIME_ELAPSED, queries[activeQuery]);
+    }
+}
+
+glm::vec2 DynamicResolution::jitter() const {
+    if (!temporalProgram) {
+        return glm::vec2(0.0f);
+    }
+    // Halton points within the pixel, relative to its center, in clip units (2 / size per render-scale pixel).
+    const int phase = static_cast<int>(frame % jitterPhases) + 1;
+    return glm::vec2((halton(phase, 2) - 0.5f) * 2.0f / static_cast<float>(renderWidth),
+                     (halton(phase, 3) - 0.5f) * 2.0f / static_cast<float>(renderHeight));
+}
+
+void DynamicResolution::setSceneTransform(const glm::mat4& mvp) {
+    const glm::mat4 jittered = glm::translate(glm::mat4(1.0f), glm::vec3(jitter(), 0.0f)) * mvp;
+    currentToPrevious = previousTransform * glm::inverse(jittered);
+    previousTransform = mvp;
+}
+
+GLuint DynamicResolution::resolveTemporal() {
+    const int write = 1 - historyIndex;
+    glState.bindFramebuffer(historyFbo[write]);
+    glState.viewport(0, 0, renderWidth, renderHeight);
+
+    glState.useProgram(temporalProgram);
+    glUniform2f(glGetUniformLocation(temporalProgram, "renderSize"), static_cast<float>(renderWidth), static_cast<float>(renderHeight));
+    glUniformMatrix4fv(glGetUniformLocation(temporalProgram, "currentToPrevious"), 1, GL_FALSE, glm::value_ptr(currentToPrevious));
+    glUniform1f(glGetUniformLocation(temporalProgram, "historyWeight"), historyValid ? historyWeight : 0.0f);
+    glState.bindTexture(0, GL_TEXTURE_2D, color);
+    glState.bindTexture(1, GL_TEXTURE_2D, depthTexture);
+    glState.bindTexture(2, GL_TEXTURE_2D, history[historyIndex]);
+    glState.bindVertexArray(emptyVao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    historyIndex = write;
+    historyValid = true;
+    return history[write];
+}
+
+void DynamicResolution::end() {
+    glQueryCounter(timestamps[timedFrame][1], GL_TIMESTAMP);
+    if (!upscaleProgram) {
+        timedPost[timedFrame] = false;
+        timestampsPending[timedFrame] = true;
+        timedFrame = (timedFrame + 1) % timedFrames;
+        return;
+    }
+    if (activeQuery >= 0) {
+        glEndQuery(GL_TIME_ELAPSED);
+        queryPending[activeQuery] = true;
+        activeQuery = -1;
+    }
+    if (dynamic) {
+        readTimings();
+    }
+
+    if (sampleCount > 1) {
+        glState.blitFramebuffer(msaaFbo, fbo, renderWidth, renderHeight);
+    }
+
+    if (!programsLinked) {
+        programsLinked = true;
+        finishProgram(upscaleProgram);
+        glState.useProgram(upscaleProgram);
+        glUniform1i(glGetUniformLocation(upscaleProgram, "scene"), 0);
+        if (temporalProgram) {
+            finishProgram(temporalProgram);
+            glState.useProgram(temporalProgram);
+            glUniform1i(glGetUniformLocation(temporalProgram, "scene"), 0);
+            glUniform1i(glGetUniformLocation(temporalProgram, "sceneDepth"), 1);
+            glUniform1i(glGetUniformLocation(temporalProgram, "history"), 2);
+        }
+    }
+
+    glState.setEnabled(GL_DEPTH_TEST, false);
+    const GLuint upscaled = temporalProgram ? resolveTemporal() : color;
+
+    glState.bindFramebuffer(0);
+    glState.viewport(0, 0, windowWidth, windowHeight);
+
+    glState.useProgram(upscaleProgram);
+    glUniform2f(glGetUniformLocation(upscaleProgram, "renderSize"), static_cast<float>(renderWidth), static_cast<float>(renderHeight));
+    glState.bindTexture(0, GL_TEXTURE_2D, upscaled);
+    glState.bindVertexArray(emptyVao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    glState.setEnabled(GL_DEPTH_TEST, true);
+    glQueryCounter(timestamps[timedFrame][2], GL_TIMESTAMP);
+    timedPost[timedFrame] = true;
+    timestampsPending[timedFrame] = true;
+    timedFrame = (timedFrame + 1) % timedFrames;
+    ++frame;
+}
+
+void DynamicResolution::readCosts() {
+    // The slot about to be reused was issued frames ago; if it still isn't done, drop it rather than wait.
+    if (!timestampsPending[timedFrame]) {
+        return;
+    }
+    timestampsPending[timedFrame] = false;
+    const int last = timedPost[timedFrame] ? 2 : 1;
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(timestamps[timedFrame][last], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return;
+    }
+
+    GLuint64 times[3] = {};
+    for (int i = 0; i <= last; ++i) {
+        glGetQueryObjectui64v(timestamps[timedFrame][i], GL_QUERY_RESULT, &times[i]);
+    }
+    sceneMsTotal += static_cast<double>(times[1] - times[0]) * 1e-6;
+    if (timedPost[timedFrame]) {
+        postMsTotal += static_cast<double>(times[2] - times[1]) * 1e-6;
+    }
+    ++timedCount;
+}
+
+void DynamicResolution::report() const {
+    std::cout << "   → Anti-aliasing: " << antiAliasingName(antiAliasing, sampleCount);
+    if (timedCount > 0) {
+        std::cout << ", GPU per frame: scene " << sceneMsTotal / static_cast<double>(timedCount) << " ms, resolve, anti-aliasing and upscale "
+                  << postMsTotal / static_cast<double>(timedCount) << " ms";
+    }
+    std::cout << "\n";
+}
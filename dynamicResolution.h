@@ -0,0 +1,119 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "options.h"
+
+class DynamicResolution {
+    /*
+     * The scene is drawn into an offscreen target at `scale` times the window's framebuffer size
+     * and upscaled into the window (bilinear, or with a clamped unsharp mask). With a dynamic
+     * scale, GPU time of the scene is measured with a small ring of GL_TIME_ELAPSED queries, read
+     * back frames later without stalling, normalised by the scale each frame was drawn at and
+     * smoothed; the scale is then chosen so the scene fits `budgetMs`.
+     *
+     * The scale moves in steps of `scaleStep`, down as soon as the budget is missed and up only
+     * with a step of headroom, so the targets that depend on the viewport (the streamed marble's
+     * feedback pass) are rarely reallocated. A fixed scale of 1 draws straight into the window.
+     *
+     * With multisampling the scene is drawn into multisampled renderbuffers and resolved into the
+     * texture the upscale reads, with a blit of the drawn part only. FXAA runs in the upscale pass
+     * on the render-scale texels. TAA offsets the projection by a Halton(2, 3) sub-pixel jitter each
+     * frame and blends the scene into a history at render scale before the upscale: the history
+     * is reprojected through the scene's depth with this and last frame's transforms, which is
+     * exact here since everything drawn shares one model matrix, and clamped to the range of the
+     * current 3x3 neighbourhood so stale history doesn't ghost. Either forces the offscreen target.
+     *
+     * GPU time of the scene and of everything after it (resolve, anti-aliasing and upscale) is
+     * measured every frame with timestamp queries, for report().
+     */
+
+    public:
+        DynamicResolution(
+            double budgetMs,            // GPU time the scene may take per frame
+            float fixedScale,           // 0 for a dynamic scale
+            UpscaleFilter filter,
+            AntiAliasing antiAliasing,
+            int samples                 // Multisamples of the offscreen target; the window's own are used when drawing into it
+        );
+        DynamicResolution(const DynamicResolution&) = delete;
+        DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+        // Deletes the GL objects; call before the window is destroyed, the destructor runs too late for GL.
+        void release();
+
+        // Bind the target for a window framebuffer of this size and set the viewport; starts timing the scene.
+        void begin(int windowWidth, int windowHeight);
+        // Stop timing, adjust the scale from finished measurements and upscale into the window.
+        void end();
+
+        [[nodiscard]] float scale() const { return currentScale; }
+
+        // Samples per pixel of what is being drawn; 0 or 1 without multisampling.
+        [[nodiscard]] int samples() const { return sampleCount; }
+
+        // Aspect ratio of what is being drawn.
+        [[nodiscard]] float aspect() const { return static_cast<float>(windowWidth) / static_cast<float>(windowHeight); }
+
+        // Offset to add to clip-space x and y (times w) this frame; zero unless TAA.
+        [[nodiscard]] glm::vec2 jitter() const;
+        // The scene's unjittered model-view-projection this frame, between begin() and end(), for TAA's reprojection.
+        void setSceneTransform(const glm::mat4& mvp);
+
+        // GPU time per frame of the scene and of the anti-aliasing and upscale after it.
+        void report() const;
+
+    private:
+        static constexpr float minScale = 0.5f;
+        static constexpr float maxDynamicScale = 1.0f;
+        static constexpr float scaleStep = 0.05f;
+        static constexpr int queryCount = 4;
+        static constexpr int jitterPhases = 8;
+        static constexpr float historyWeight = 0.9f;   // Of the reprojected history in TAA's blend
+
+        double budgetMs;
+        AntiAliasing antiAliasing;
+        bool dynamic;
+        float currentScale;
+        double msPerScaleSquared = 0.0;     // Smoothed scene cost at scale 1; cost grows with the pixel count
+
+        int windowWidth = 1, windowHeight = 1;
+        int renderWidth = 0, renderHeight = 0;
+        int targetWidth = 0, targetHeight = 0;
+        int sampleCount = 0;
+        GLuint fbo = 0, color = 0, depth = 0;
+        GLuint msaaFbo = 0, msaaColor = 0, msaaDepth = 0;     // Drawn into when sampleCount > 1, resolved into `color`
+        GLuint depthTexture = 0;                                // Instead of `depth` with TAA, which reads it
+
+        GLuint historyFbo[2]{}, history[2]{};
+        int historyIndex = 0;                   // The one written last
+        bool historyValid = false;              // Drawn at the current render size
+        long frame = 0;
+        glm::mat4 previousTransform{ 1.0f };
+        glm::mat4 currentToPrevious{ 1.0f };    // This frame's jittered clip space to last frame's unjittered one
+
+        GLuint queries[queryCount]{};
+        float queryScales[queryCount]{};
+        bool queryPending[queryCount]{};
+        int nextQuery = 0;
+        int activeQuery = -1;
+
+        static constexpr int timedFrames = 4;
+        GLuint timestamps[timedFrames][3]{};    // Scene start, scene end, upscale end
+        bool timestampsPending[timedFrames]{};
+        bool timedPost[timedFrames]{};
+        int timedFrame = 0;
+        long timedCount = 0;
+        double sceneMsTotal = 0.0, postMsTotal = 0.0;
+
+        GLuint upscaleProgram = 0, temporalProgram = 0, emptyVao = 0;
+        bool programsLinked = false;
+
+        void allocateTarget(int width, int height);
+        void readTimings();
+        void readCosts();
+        GLuint resolveTemporal();
+};
+
+#endif //DYNAMICRESOLUTION_H
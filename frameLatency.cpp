@@ -0,0 +1,104 @@
+#include "frameLatency.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+
+FrameLatency::FrameLatency(int maxFramesInFlight, bool measure)
+    : maxInFlight(std::min(maxFramesInFlight, slotCount - 1)), measuring(measure || maxFramesInFlight > 0) {
+    for (Slot& slot : slots) {
+        glGenQueries(1, &slot.query);
+    }
+    if (bounded()) {
+        std::cout << "🔍 Low latency: at most " << maxInFlight << (maxInFlight == 1 ? " frame" : " frames")
+                  << " in flight, input read after the wait\n";
+    }
+}
+
+void FrameLatency::release() {
+    for (Slot& slot : slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        glDeleteQueries(1, &slot.query);
+        slot.query = 0;
+        slot.pending = false;
+    }
+}
+
+void FrameLatency::collect(Slot& slot, bool wait, bool reuse) {
+    if (!slot.pending) {
+        return;
+    }
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(slot.query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available && !wait) {
+        if (reuse) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            slot.pending = false;
+        }
+        return;
+    }
+    GLint64 finishedAt = 0;
+    glGetQueryObjecti64v(slot.query, GL_QUERY_RESULT, &finishedAt);
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    slot.pending = false;
+
+    const double latencyMs = static_cast<double>(finishedAt - slot.sampledAt) * 1e-6;
+    latencyTotalMs += latencyMs;
+    latencyMaxMs = std::max(latencyMaxMs, latencyMs);
+    ++measured;
+}
+
+void FrameLatency::beginFrame() {
+    if (!measuring) {
+        return;
+    }
+    if (bounded()) {
+        Slot& oldest = slots[(current - maxInFlight + slotCount) % slotCount];
+        if (oldest.fence && glClientWaitSync(oldest.fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            const auto start = std::chrono::steady_clock::now();
+            while (glClientWaitSync(oldest.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100'000'000) == GL_TIMEOUT_EXPIRED) {
+            }
+            waitedMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            ++waits;
+        }
+    }
+    for (int i = 1; i < slotCount; ++i) {
+        collect(slots[(current + i) % slotCount], false);
+    }
+
+    // Bounded, this slot's frame is already done; without a bound, waiting on it would cap the queue.
+    Slot& slot = slots[current];
+    collect(slot, bounded(), true);
+    glGetInteger64v(GL_TIMESTAMP, &slot.sampledAt);
+}
+
+void FrameLatency::endFrame() {
+    if (!measuring) {
+        return;
+    }
+    Slot& slot = slots[current];
+    glQueryCounter(slot.query, GL_TIMESTAMP);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.pending = true;
+    current = (current + 1) % slotCount;
+}
+
+void FrameLatency::report() const {
+    std::cout << "   → Frames in flight: ";
+    if (bounded()) {
+        std::cout << "at most " << maxInFlight << ", waited for the GPU " << waits << " times ("
+                  << (waits > 0 ? waitedMs / static_cast<double>(waits) : 0.0) << " ms on average)\n";
+    } else {
+        std::cout << "left to the driver\n";
+    }
+    if (measured > 0) {
+        std::cout << "   → Input to GPU done: " << latencyTotalMs / static_cast<double>(measured) << " ms on average, "
+                  << latencyMaxMs << " ms at most\n";
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef FRAMELATENCY_H
+#define FRAMELATENCY_H
+#include <GL/glew.h>
+
+#include <array>
+
+class FrameLatency {
+    /*
+     * Bounds how many frames the CPU may queue ahead of the GPU, and measures how old a frame's
+     * input and animation time are by the time the GPU has finished it.
+     *
+     * Each frame ends with a fence and a GL_TIMESTAMP query after the swap. With a bound of N,
+     * beginFrame() waits on the fence of the frame N back, so the driver never holds more than N
+     * frames and the next frame's input is read only once there is room for it. The latency is
+     * the GPU clock at that query minus the GPU clock read in beginFrame(), when the frame's
+     * input and time were sampled; scanout is not included. Reading the GPU clock may sync with
+     * the GPU on some drivers, so without a bound it is measured only on request.
+     */
+
+    public:
+        FrameLatency(
+            int maxFramesInFlight,      // 0 leaves the queue depth to the driver
+            bool measure                // Measure latency without a bound too; always on with one
+        );
+        FrameLatency(const FrameLatency&) = delete;
+        FrameLatency& operator=(const FrameLatency&) = delete;
+
+        // Deletes the fences and queries; call before the window is destroyed, the destructor runs too late for GL.
+        void release();
+
+        // Before the frame reads input and the clock.
+        void beginFrame();
+        // After glfwSwapBuffers().
+        void endFrame();
+
+        [[nodiscard]] bool bounded() const { return maxInFlight > 0; }
+
+        // Frames in flight, time spent waiting for the GPU, and latency.
+        void report() const;
+
+    private:
+        static constexpr int slotCount = 4;     // Beyond the frame data ring's three frames, so a slot is always free
+
+        struct Slot {
+            GLsync fence = nullptr;
+            GLuint query = 0;
+            GLint64 sampledAt = 0;              // GPU clock when the frame's input was read
+            bool pending = false;
+        };
+
+        int maxInFlight;
+        bool measuring;
+        std::array<Slot, slotCount> slots{};
+        int current = 0;
+
+        long waits = 0;
+        double waitedMs = 0.0;
+        long measured = 0;
+        double latencyTotalMs = 0.0, latencyMaxMs = 0.0;
+
+        // Read the slot's timestamp once it is available; `wait` blocks until it is, otherwise an
+        // unfinished slot that must be reused is dropped.
+        void collect(Slot& slot, bool wait, bool reuse = false);
+};
+
+#endif //FRAMELATENCY_H
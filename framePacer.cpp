@@ -0,0 +1,116 @@
+#include "framePacer.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+
+static double processCpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto seconds = [](const timeval& time) { return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) * 1e-6; };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+PacingMode pacingModeFor(GLFWwindow* window) {
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED) || !glfwGetWindowAttrib(window, GLFW_VISIBLE) || width == 0 || height == 0) {
+        return PacingMode::Hidden;
+    }
+    return glfwGetWindowAttrib(window, GLFW_FOCUSED) ? PacingMode::Active : PacingMode::Unfocused;
+}
+
+FramePacer::FramePacer(double targetFps, double unfocusedFps)
+    : activeInterval(targetFps > 0.0 ? 1.0 / targetFps : 0.0),
+      unfocusedInterval(unfocusedFps > 0.0 ? 1.0 / unfocusedFps : 0.0),
+      nextFrame(Clock::now()),
+      cpuSince(processCpuSeconds()) {
+}
+
+void FramePacer::account(PacingMode nextMode) {
+    const Clock::time_point now = Clock::now();
+    const double cpu = processCpuSeconds();
+
+    ModeStats& mode = stats[static_cast<int>(accountedMode)];
+    mode.wallSeconds += std::chrono::duration<double>(now - accountedSince).count();
+    mode.cpuSeconds += cpu - cpuSince;
+
+    accountedMode = nextMode;
+    accountedSince = now;
+    cpuSince = cpu;
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline) {
+    using Seconds = std::chrono::duration<double>;
+
+    const double remaining = Seconds(deadline - Clock::now()).count();
+    if (remaining > spinMargin) {
+        const double requested = remaining - spinMargin;
+        const Clock::time_point before = Clock::now();
+        std::this_thread::sleep_for(Seconds(requested));
+        const double late = Seconds(Clock::now() - before).count() - requested;
+
+        // Spin for twice the usual oversleep: enough to absorb a slow wake-up, little enough to stay idle.
+        oversleep += 0.1 * (std::max(late, 0.0) - oversleep);
+        spinMargin = std::clamp(2.0 * oversleep, 0.0002, 0.004);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+bool FramePacer::waitForFrame(GLFWwindow* window) {
+    const PacingMode mode = pacingModeFor(window);
+    if (mode != accountedMode) {
+        account(mode);
+        nextFrame = Clock::now();   // Don't try to catch up on the frames another mode skipped
+    }
+
+    if (mode == PacingMode::Hidden) {
+        glfwWaitEvents();
+        return false;
+    }
+
+    const double interval = (mode == PacingMode::Active) ? activeInterval : unfocusedInterval;
+    if (interval > 0.0) {
+        const auto step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+        Clock::time_point now = Clock::now();
+
+        // Stay on the grid unless a frame ran more than a whole interval late; then start a new one from now.
+        nextFrame = (now - nextFrame > step) ? now : nextFrame;
+        if (mode == PacingMode::Active) {
+            sleepUntil(nextFrame);
+            glfwPollEvents();
+        } else {
+            for (; now < nextFrame && pacingModeFor(window) == mode; now = Clock::now()) {
+                glfwWaitEventsTimeout(std::chrono::duration<double>(nextFrame - now).count());
+            }
+            glfwPollEvents();
+        }
+        nextFrame += step;
+    } else {
+        glfwPollEvents();
+    }
+
+    ++stats[static_cast<int>(mode)].frames;
+    return true;
+}
+
+void FramePacer::report() {
+    account(accountedMode);
+
+    static const char* const names[] = { "active", "unfocused", "hidden" };
+    std::cout << "📊 Frame pacing:\n";
+    for (int i = 0; i < static_cast<int>(PacingMode::Count); ++i) {
+        const ModeStats& mode = stats[i];
+        if (mode.wallSeconds <= 0.0) {
+            continue;
+        }
+        std::cout << "   → " << names[i] << ": " << mode.wallSeconds << " s, " << mode.frames << " frames ("
+                  << static_cast<double>(mode.frames) / mode.wallSeconds << " fps), CPU "
+                  << 100.0 * mode.cpuSeconds / mode.wallSeconds << " %\n";
+    }
+}
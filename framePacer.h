@@ -0,0 +1,60 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+
+enum class PacingMode {
+    Active,     // Focused and visible: --fps, or as fast as the swap allows
+    Unfocused,  // Visible behind another window: --unfocused-fps
+    Hidden,     // Iconified, invisible or zero-sized: nothing is drawn, the loop sleeps on events
+    Count
+};
+
+// Hidden, Unfocused or Active, from the window's attributes.
+PacingMode pacingModeFor(GLFWwindow* window);
+
+class FramePacer {
+    /*
+     * Decides when the main loop draws. Frames are scheduled on a fixed grid of 1/fps; the wait
+     * sleeps for most of the interval and spins (yielding) for the rest, with the spin margin
+     * adapted to how far the OS has been oversleeping, so frames start on time without burning
+     * the whole interval. Unfocused frames wait in glfwWaitEventsTimeout() instead, so regaining
+     * focus is immediate; hidden windows block in glfwWaitEvents() and draw nothing.
+     *
+     * Wall and process CPU time are accounted per mode and printed by report().
+     */
+
+    public:
+        FramePacer(double targetFps, double unfocusedFps);
+
+        // Wait for the window's next frame and process events. False when this iteration should not draw.
+        bool waitForFrame(GLFWwindow* window);
+
+        // Frames, rate and CPU usage (of one core) per mode.
+        void report();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct ModeStats {
+            double wallSeconds = 0.0;
+            double cpuSeconds = 0.0;
+            long frames = 0;
+        };
+
+        double activeInterval, unfocusedInterval;  // Seconds; 0 leaves pacing to the swap
+        Clock::time_point nextFrame;
+        double spinMargin = 0.002;                  // Seconds before the deadline at which sleeping stops
+        double oversleep = 0.0;                     // Running average of how late sleeps return
+
+        PacingMode accountedMode = PacingMode::Active;
+        Clock::time_point accountedSince = Clock::now();
+        double cpuSince;
+        ModeStats stats[static_cast<int>(PacingMode::Count)];
+
+        void account(PacingMode nextMode);
+        void sleepUntil(Clock::time_point deadline);
+};
+
+#endif //FRAMEPACER_H
@@ -0,0 +1,266 @@
+#include "glState.h"
+
+#include <algorithm>
+#include <iostream>
+
+
+void GLStateCache::init() {
+    dsa = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+    bufferStorage = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+    textureStorage = GLEW_VERSION_4_2 || GLEW_ARB_texture_storage;
+    invalidate();
+}
+
+void GLStateCache::invalidate() {
+    currentProgram = unknown;
+    currentVertexArray = unknown;
+    currentFramebuffer = unknown;
+    activeUnit = unknown;
+    viewportRect = { -1, -1, -1, -1 };
+    capabilities.clear();
+    textures.clear();
+    indexedBuffers.clear();
+}
+
+bool GLStateCache::changed(bool differs) {
+    ++(differs ? issued : elided);
+    return differs;
+}
+
+void GLStateCache::useProgram(GLuint program) {
+    if (changed(program != currentProgram)) {
+        glUseProgram(program);
+        currentProgram = program;
+    }
+}
+
+void GLStateCache::bindVertexArray(GLuint vertexArray) {
+    if (changed(vertexArray != currentVertexArray)) {
+        glBindVertexArray(vertexArray);
+        currentVertexArray = vertexArray;
+    }
+}
+
+void GLStateCache::bindFramebuffer(GLuint framebuffer) {
+    if (changed(framebuffer != currentFramebuffer)) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        currentFramebuffer = framebuffer;
+    }
+}
+
+void GLStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    const std::array<GLint, 4> rect{ x, y, width, height };
+    if (changed(rect != viewportRect)) {
+        glViewport(x, y, width, height);
+        viewportRect = rect;
+    }
+}
+
+void GLStateCache::setEnabled(GLenum capability, bool enabled) {
+    auto it = capabilities.find(capability);
+    if (changed(it == capabilities.end() || it->second != enabled)) {
+        (enabled ? glEnable : glDisable)(capability);
+        capabilities[capability] = enabled;
+    }
+}
+
+void GLStateCache::activeTexture(GLuint unit) {
+    if (changed(unit != activeUnit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        activeUnit = unit;
+    }
+}
+
+void GLStateCache::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+    GLuint& bound = textures.try_emplace((static_cast<uint64_t>(unit) << 32) | target, unknown).first->second;
+    if (!changed(texture != bound)) {
+        return;
+    }
+    if (dsa && texture != 0) {
+        glBindTextureUnit(unit, texture);
+    } else {
+        activeTexture(unit);
+        glBindTexture(target, texture);
+    }
+    bound = texture;
+}
+
+void GLStateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    bindBufferRange(target, index, buffer, 0, 0);
+}
+
+void GLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    const BufferBinding binding{ buffer, offset, size };
+    auto [it, inserted] = indexedBuffers.try_emplace((static_cast<uint64_t>(target) << 32) | index, binding);
+    const BufferBinding& bound = it->second;
+    if (!changed(inserted || bound.buffer != buffer || bound.offset != offset || bound.size != size)) {
+        return;
+    }
+    if (size == 0) {
+        glBindBufferBase(target, index, buffer);
+    } else {
+        glBindBufferRange(target, index, buffer, offset, size);
+    }
+    it->second = binding;
+}
+
+GLuint GLStateCache::program() {
+    if (currentProgram == unknown) {
+        GLint program = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        currentProgram = static_cast<GLuint>(program);
+    }
+    return currentProgram;
+}
+
+GLuint GLStateCache::framebuffer() {
+    if (currentFramebuffer == unknown) {
+        GLint framebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+        currentFramebuffer = static_cast<GLuint>(framebuffer);
+    }
+    return currentFramebuffer;
+}
+
+std::array<GLint, 4> GLStateCache::currentViewport() {
+    if (viewportRect[2] < 0) {
+        glGetIntegerv(GL_VIEWPORT, viewportRect.data());
+    }
+    return viewportRect;
+}
+
+GLuint GLStateCache::createBuffer(GLsizeiptr size, const void* data, GLbitfield storageFlags) {
+    GLuint buffer = 0;
+    if (dsa) {
+        glCreateBuffers(1, &buffer);
+        glNamedBufferStorage(buffer, size, data, storageFlags);
+        return buffer;
+    }
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (bufferStorage) {
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size, data, storageFlags);
+    } else {
+        glBufferData(GL_COPY_WRITE_BUFFER, size, data, (storageFlags & GL_DYNAMIC_STORAGE_BIT) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    }
+    return buffer;
+}
+
+void* GLStateCache::mapBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr size, GLbitfield access) {
+    if (dsa) {
+        return glMapNamedBufferRange(buffer, offset, size, access);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    return glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size, access);
+}
+
+void GLStateCache::unmapBuffer(GLuint buffer) {
+    if (dsa) {
+        glUnmapNamedBuffer(buffer);
+        return;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+}
+
+void GLStateCache::bufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data) {
+    if (dsa) {
+        glNamedBufferSubData(buffer, offset, size, data);
+        return;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+}
+
+GLuint GLStateCache::createTexture(GLenum target) {
+    GLuint texture = 0;
+    if (dsa) {
+        glCreateTextures(target, 1, &texture);
+    } else {
+        glGenTextures(1, &texture);
+    }
+    return texture;
+}
+
+void GLStateCache::bindTextureForEdit(GLenum target, GLuint texture) {
+    bindTexture(editUnit, target, texture);
+    activeTexture(editUnit);
+}
+
+void GLStateCache::deleteTexture(GLuint texture) {
+    std::erase_if(textures, [texture](const auto& binding) { return binding.second == texture; });
+    glDeleteTextures(1, &texture);
+}
+
+void GLStateCache::deleteFramebuffer(GLuint framebuffer) {
+    if (framebuffer == currentFramebuffer) {
+        currentFramebuffer = unknown;
+    }
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+void GLStateCache::blitFramebuffer(GLuint source, GLuint destination, GLsizei width, GLsizei height) {
+    if (dsa) {
+        glBlitNamedFramebuffer(source, destination, 0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        return;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, source);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, destination);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    currentFramebuffer = unknown;
+}
+
+void GLStateCache::textureStorage2D(GLuint texture, GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height) {
+    if (dsa) {
+        glTextureStorage2D(texture, levels, internalFormat, width, height);
+        return;
+    }
+    bindTextureForEdit(target, texture);
+    if (textureStorage) {
+        glTexStorage2D(target, levels, internalFormat, width, height);
+        return;
+    }
+    const bool depth = internalFormat == GL_DEPTH_COMPONENT24 || internalFormat == GL_DEPTH_COMPONENT32F;
+    for (GLsizei level = 0; level < levels; ++level) {
+        glTexImage2D(target, level, static_cast<GLint>(internalFormat), std::max(1, width >> level), std::max(1, height >> level), 0,
+                     depth ? GL_DEPTH_COMPONENT : GL_RGBA, depth ? GL_UNSIGNED_INT : GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
+
+void GLStateCache::textureParameter(GLuint texture, GLenum target, GLenum name, GLint value) {
+    if (dsa) {
+        glTextureParameteri(texture, name, value);
+        return;
+    }
+    bindTextureForEdit(target, texture);
+    glTexParameteri(target, name, value);
+}
+
+void GLStateCache::textureSubImage2D(GLuint texture, GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+                                     GLenum format, GLenum type, const void* pixels) {
+    if (dsa) {
+        glTextureSubImage2D(texture, level, x, y, width, height, format, type, pixels);
+        return;
+    }
+    bindTextureForEdit(target, texture);
+    glTexSubImage2D(target, level, x, y, width, height, format, type, pixels);
+}
+
+void GLStateCache::beginFrame() {
+    if (frames > 0) {
+        totalIssued += issued;
+        totalElided += elided;
+    }
+    ++frames;
+    issued = 0;
+    elided = 0;
+}
+
+void GLStateCache::report() const {
+    const long counted = std::max(frames - 1, 1L);
+    std::cout << "   → GL state calls per frame: " << static_cast<double>(totalIssued) / static_cast<double>(counted) << " issued, "
+              << static_cast<double>(totalElided) / static_cast<double>(counted) << " elided"
+              << (dsa ? " (direct state access)" : " (bind to edit)") << "\n";
+}
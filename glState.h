@@ -0,0 +1,111 @@
+#ifndef GLSTATE_H
+#define GLSTATE_H
+#include <GL/glew.h>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+class GLStateCache {
+    /*
+     * A thin layer over the GL state the frame touches: it remembers what is bound and skips
+     * calls that would not change anything, counting issued and skipped calls per frame. Code
+     * that changes this state behind its back must call invalidate() afterwards.
+     *
+     * With GL 4.5 (or GL_ARB_direct_state_access) objects are created and edited by name
+     * (glCreate*, glNamedBufferStorage, glTextureStorage2D, glTextureSubImage2D, ...) and
+     * textures are bound with glBindTextureUnit. Without it, edits bind the object first:
+     * textures on a unit reserved for editing, buffers on GL_COPY_WRITE_BUFFER, so neither
+     * disturbs the bindings the draws use.
+     */
+
+    public:
+        // After glewInit(): detects DSA and forgets all state.
+        void init();
+        // Forget all state; the next call for each binding is issued.
+        void invalidate();
+
+        [[nodiscard]] bool directStateAccess() const { return dsa; }
+
+        // Binding
+        void useProgram(GLuint program);
+        void bindVertexArray(GLuint vertexArray);
+        void bindFramebuffer(GLuint framebuffer);               // GL_FRAMEBUFFER: both draw and read
+        void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+        void setEnabled(GLenum capability, bool enabled);
+        void bindTexture(GLuint unit, GLenum target, GLuint texture);
+        void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+        void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+        // Current state, queried from GL only while unknown.
+        [[nodiscard]] GLuint program();
+        [[nodiscard]] GLuint framebuffer();
+        [[nodiscard]] std::array<GLint, 4> currentViewport();
+
+        // Objects
+        GLuint createBuffer(
+            /*
+             * Immutable storage when available. `storageFlags` are glBufferStorage's; without it
+             * the buffer gets glBufferData with GL_DYNAMIC_DRAW if GL_DYNAMIC_STORAGE_BIT is set,
+             * GL_STATIC_DRAW otherwise, and persistent mapping is unavailable.
+             */
+
+            GLsizeiptr size,
+            const void* data,
+            GLbitfield storageFlags
+        );
+        void* mapBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr size, GLbitfield access);
+        void unmapBuffer(GLuint buffer);
+        void bufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data);
+
+        GLuint createTexture(GLenum target);
+        // GL_RGBA8-compatible or depth formats; falls back to glTexImage2D per level without texture storage.
+        void textureStorage2D(GLuint texture, GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height);
+        void textureParameter(GLuint texture, GLenum target, GLenum name, GLint value);
+        void textureSubImage2D(GLuint texture, GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+                               GLenum format, GLenum type, const void* pixels);
+        // Bind on the edit unit for calls that have no by-name form here (glTexImage*, glGenerateMipmap).
+        void bindTextureForEdit(GLenum target, GLuint texture);
+
+        // Deleting through the cache, so a name the driver hands out again is not mistaken for the old binding.
+        void deleteTexture(GLuint texture);
+        void deleteFramebuffer(GLuint framebuffer);
+        // Color only, same rectangle (a multisample resolve); leaves the framebuffer binding to the next bindFramebuffer().
+        void blitFramebuffer(GLuint source, GLuint destination, GLsizei width, GLsizei height);
+
+        // Counters
+        void beginFrame();
+        void report() const;
+
+    private:
+        static constexpr GLuint unknown = ~0u;
+        static constexpr GLuint editUnit = 15;      // GL 3.3 guarantees 16 fragment units; draws use the low ones
+
+        bool dsa = false;
+        bool bufferStorage = false;
+        bool textureStorage = false;
+
+        GLuint currentProgram = unknown;
+        GLuint currentVertexArray = unknown;
+        GLuint currentFramebuffer = unknown;
+        GLuint activeUnit = unknown;
+        std::array<GLint, 4> viewportRect{ -1, -1, -1, -1 };
+        std::unordered_map<GLenum, bool> capabilities;
+        std::unordered_map<uint64_t, GLuint> textures;          // unit << 32 | target
+        struct BufferBinding {
+            GLuint buffer;
+            GLintptr offset;
+            GLsizeiptr size;
+        };
+        std::unordered_map<uint64_t, BufferBinding> indexedBuffers;    // target << 32 | index
+
+        long issued = 0, elided = 0;
+        long frames = 0, totalIssued = 0, totalElided = 0;
+
+        bool changed(bool differs);
+        void activeTexture(GLuint unit);
+};
+
+inline GLStateCache glState;
+
+#endif //GLSTATE_H
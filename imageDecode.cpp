@@ -0,0 +1,199 @@
+#include "imageDecode.h"
+#include "scratchArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#define STBI_MALLOC(sz)                    imageDecodeMalloc(sz)
+#define STBI_REALLOC_SIZED(p, oldsz, newsz) imageDecodeRealloc(p, oldsz, newsz)
+#define STBI_FREE(p)                       imageDecodeFree(p)
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#ifdef PAWN_HAVE_TURBOJPEG
+#include <turbojpeg.h>
+#endif
+#include <vector>
+
+
+// The output buffer of the stb_image decode running on this thread, if any. stb_image allocates its
+// final image as width * height * channels bytes for the requested channels, plus a byte on the JPEG
+// path; only an allocation within imageDecodeHeadroom of that (and within `capacity`) may take `dst`,
+// and only while nothing else holds it.
+struct DecodeTarget {
+    unsigned char* dst;
+    size_t bytes;
+    size_t capacity;
+    bool taken = false;
+};
+static thread_local DecodeTarget* decodeTarget = nullptr;
+
+void* imageDecodeMalloc(size_t size) {
+    if (decodeTarget && !decodeTarget->taken && size >= decodeTarget->bytes &&
+        size <= std::min(decodeTarget->capacity, decodeTarget->bytes + imageDecodeHeadroom)) {
+        decodeTarget->taken = true;
+        return decodeTarget->dst;
+    }
+    return scratchMalloc(size);
+}
+
+void* imageDecodeRealloc(void* ptr, size_t oldSize, size_t newSize) {
+    if (decodeTarget && ptr && ptr == decodeTarget->dst) {
+        // Never expected for decoder output, but keep the mapped range out of realloc() regardless.
+        void* moved = scratchMalloc(newSize);
+        if (moved) {
+            memcpy(moved, ptr, std::min(oldSize, newSize));
+        }
+        decodeTarget->taken = false;
+        return moved;
+    }
+    return scratchRealloc(ptr, newSize);
+}
+
+void imageDecodeFree(void* ptr) {
+    if (decodeTarget && ptr && ptr == decodeTarget->dst) {
+        // A same-sized intermediate is done with it; the output may still land there.
+        decodeTarget->taken = false;
+        return;
+    }
+    scratchFree(ptr);
+}
+
+static bool decodeWithStb(const unsigned char* data, size_t len, unsigned char* dst, size_t capacity, int width, int height, int channels) {
+    const size_t bytes = static_cast<size_t>(width) * height * channels;
+    if (!dst || capacity < bytes) {
+        std::cerr << "❌ Decode target too small: " << capacity << " < " << bytes << " bytes\n";
+        return false;
+    }
+
+    DecodeTarget target{ dst, bytes, capacity };
+    DecodeTarget* const previous = std::exchange(decodeTarget, &target);
+
+    stbi_set_flip_vertically_on_load_thread(false);
+
+    int w, h, n;
+    unsigned char* pixels = stbi_load_from_memory(data, static_cast<int>(len), &w, &h, &n, channels);
+
+    const bool redirected = target.taken && pixels == dst;
+    decodeTarget = previous;
+
+    if (!pixels) {
+        std::cerr << "❌ stbi_load_from_memory failed: " << stbi_failure_reason() << "\n";
+        return false;
+    }
+
+    if (w != width || h != height) {
+        std::cerr << "❌ Decoded size " << w << "x" << h << " does not match " << width << "x" << height << "\n";
+        if (!redirected) {
+            stbi_image_free(pixels);
+        }
+        return false;
+    }
+
+    if (!redirected) {
+        // The decoder allocated elsewhere (e.g. no headroom in `dst`); fall back to a single copy.
+        std::cerr << "❌ Decoder output missed the target (" << capacity << " bytes for " << bytes << "), copying it\n";
+        memcpy(dst, pixels, bytes);
+        stbi_image_free(pixels);
+    }
+    return true;
+}
+
+#ifdef PAWN_HAVE_TURBOJPEG
+static bool isJpeg(const unsigned char* data, size_t len) {
+    return len >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+}
+
+static bool decodeWithTurboJpeg(const unsigned char* data, size_t len, unsigned char* dst, int width, int height, int channels) {
+    tjhandle handle = tjInitDecompress();
+    if (!handle) {
+        std::cerr << "❌ tjInitDecompress failed: " << tjGetErrorStr() << "\n";
+        return false;
+    }
+
+    // Given the scaled size, libjpeg-turbo picks the matching DCT scaling factor and skips the unneeded coefficients.
+    const int pixelFormat = (channels == 4) ? TJPF_RGBA : (channels == 3) ? TJPF_RGB : TJPF_GRAY;
+    const bool decoded = tjDecompress2(handle, data, static_cast<unsigned long>(len), dst, width, 0, height, pixelFormat, 0) == 0;
+    if (!decoded) {
+        std::cerr << "❌ tjDecompress2 failed: " << tjGetErrorStr2(handle) << "\n";
+    }
+    tjDestroy(handle);
+    return decoded;
+}
+#endif
+
+static void boxDownsample(const unsigned char* src, int srcWidth, int srcHeight, int channels, int scale, unsigned char* dst, int width, int height) {
+    // Averages each `scale` x `scale` footprint (clipped at the edges); `dst` is only written, one row at a time.
+    std::vector<unsigned char> row(static_cast<size_t>(width) * channels);
+    for (int y = 0; y < height; ++y) {
+        const int y1 = std::min((y + 1) * scale, srcHeight);
+        for (int x = 0; x < width; ++x) {
+            const int x1 = std::min((x + 1) * scale, srcWidth);
+            for (int c = 0; c < channels; ++c) {
+                unsigned sum = 0, count = 0;
+                for (int sy = y * scale; sy < y1; ++sy) {
+                    for (int sx = x * scale; sx < x1; ++sx) {
+                        sum += src[(static_cast<size_t>(sy) * srcWidth + sx) * channels + c];
+                        ++count;
+                    }
+                }
+                row[static_cast<size_t>(x) * channels + c] = static_cast<unsigned char>((sum + count / 2) / count);
+            }
+        }
+        memcpy(dst + static_cast<size_t>(y) * row.size(), row.data(), row.size());
+    }
+}
+
+bool imageDecodeSize(const unsigned char* data, size_t len, int scale, int& width, int& height, int& channels) {
+    if (!stbi_info_from_memory(data, static_cast<int>(len), &width, &height, &channels)) {
+        return false;
+    }
+    // Rounds up, exactly like JPEG DCT scaling (TJSCALED).
+    width = (width + scale - 1) / scale;
+    height = (height + scale - 1) / scale;
+    return true;
+}
+
+bool imageDecodeScalesInDct(const unsigned char* data, size_t len) {
+#ifdef PAWN_HAVE_TURBOJPEG
+    return isJpeg(data, len);
+#else
+    (void)data;
+    (void)len;
+    return false;
+#endif
+}
+
+bool decodeImageInto(const unsigned char* data, size_t len, unsigned char* dst, size_t capacity, int width, int height, int channels, int scale) {
+    const size_t bytes = static_cast<size_t>(width) * height * channels;
+    if (!dst || capacity < bytes) {
+        std::cerr << "❌ Decode target too small: " << capacity << " < " << bytes << " bytes\n";
+        return false;
+    }
+
+#ifdef PAWN_HAVE_TURBOJPEG
+    if (isJpeg(data, len)) {
+        return decodeWithTurboJpeg(data, len, dst, width, height, channels);
+    }
+#endif
+
+    if (scale == 1) {
+        return decodeWithStb(data, len, dst, capacity, width, height, channels);
+    }
+
+    // stb_image cannot scale in the DCT: decode at full size, then box-filter down.
+    int fullWidth, fullHeight, fullChannels;
+    if (!imageDecodeSize(data, len, 1, fullWidth, fullHeight, fullChannels)) {
+        std::cerr << "❌ stbi_info_from_memory failed: " << stbi_failure_reason() << "\n";
+        return false;
+    }
+    ScratchVector<unsigned char> full(static_cast<size_t>(fullWidth) * fullHeight * channels + imageDecodeHeadroom);
+    if (!decodeWithStb(data, len, full.data(), full.size(), fullWidth, fullHeight, channels)) {
+        return false;
+    }
+    boxDownsample(full.data(), fullWidth, fullHeight, channels, scale, dst, width, height);
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef IMAGEDECODE_H
+#define IMAGEDECODE_H
+#include <cstddef>
+
+// stb_image allocation hooks, see imageDecode.cpp where STB_IMAGE_IMPLEMENTATION lives.
+// Besides the decode-into-target redirect they allocate from the thread's scratch arena, if one is open.
+void* imageDecodeMalloc(size_t size);
+void* imageDecodeRealloc(void* ptr, size_t oldSize, size_t newSize);
+void imageDecodeFree(void* ptr);
+
+// Size of an image decoded at 1/`scale` (1, 2, 4 or 8), rounded up as JPEG DCT scaling does.
+// Bytes decoders may allocate past width * height * channels (stb_image's JPEG path asks for one more);
+// give decodeImageInto() targets this much extra capacity so the output can land in them directly.
+inline constexpr size_t imageDecodeHeadroom = 64;
+
+bool imageDecodeSize(const unsigned char* data, size_t len, int scale, int& width, int& height, int& channels);
+
+// True when decodeImageInto() with `scale` > 1 scales in the DCT, rather than decoding the whole image first.
+bool imageDecodeScalesInDct(const unsigned char* data, size_t len);
+
+bool decodeImageInto(
+    /*
+     * Decode an encoded image straight into `dst` (typically a mapped pixel buffer object).
+     * JPEGs go through libjpeg-turbo when built with PAWN_HAVE_TURBOJPEG, which writes `dst` directly
+     * and applies `scale` in the DCT. Otherwise stb_image's output allocation is redirected to `dst`,
+     * so the pixels are written exactly once; with `scale` > 1 they are box-filtered down instead.
+     * `width` and `height` are the scaled size from imageDecodeSize(); `dst` must hold
+     * width * height * channels bytes and `capacity` is its real size, which should include
+     * imageDecodeHeadroom for stb_image to write it in place.
+     * The image is never flipped: reading back write-combined memory would defeat the point.
+     */
+
+    const unsigned char* data,
+    size_t len,
+    unsigned char* dst,
+    size_t capacity,
+    int width,
+    int height,
+    int channels,
+    int scale = 1
+);
+
+#endif //IMAGEDECODE_H
@@ -1,10 +1,23 @@
-#define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include "imageDecode.h"
 #include "shaders.h"
 #include "setupGLFW.h"
 #include "createTextureBase.h"
+#include "asyncTextureLoader.h"
+#include "textureCompression.h"
+#include "options.h"
+#include "marbleBenchmark.h"
+#include "mipGenerator.h"
+#include "textureAtlas.h"
+#include "assetPack.h"
+#include "scratchArena.h"
+#include "virtualTexture.h"
+#include "framePacer.h"
+#include "dynamicResolution.h"
+#include "glState.h"
+#include "simulation.h"
+#include "frameLatency.h"
 #include "bezierCurvesPawn.h"
-#include "marble_downsized.h"
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -12,191 +25,625 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <utility>
 #include <chrono>
 #include <ranges>
+#include <span>
 #include <thread>
+#include <memory>
+#include <future>
 
 
 class Pawn {
     public:
         std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
-        GLuint textureMarble{}, textureBase{};
         GLuint VAO{}, VBO{}, EBO{};
+        size_t pawnVertexCount = 0;     // The marble body comes first in `vertices`, the base disc after it
+        GLsizei pawnIndexCount = 0;     // Draw ranges, in this order: marble body, base interior, base rim
+        GLsizei baseIndexCount = 0;
+        GLsizei rimIndexCount = 0;
+
+        // Startup decode and composition buffers; outlives the streamer's workers, released once everything is resident.
+        std::unique_ptr<ScratchArena> startupArena = std::make_unique<ScratchArena>();
+        TextureStreamer textureStreamer{};
+        StreamedTexture* textureMaterials = nullptr;    // GL_TEXTURE_2D_ARRAY: one layer per atlas page
+
+        struct AtlasContents {
+            AtlasRegion base, carpets[2], logo, marble;
+            bool marblePacked = false;
+            int pageWidth = 0, pageHeight = 0, pages = 0;   // No pages: the materials stay placeholders
+        };
+        AtlasContents atlas{};
+        int marbleScale = 1;                            // JPEG DCT scale the marble is decoded at
+        std::unique_ptr<VirtualTexture> marbleStream;   // --marble=streamed: tiles of the full-resolution marble
+
+        explicit Pawn(int screenHeight) {
+            generatePawnMesh(vertices, indices);
+            pawnVertexCount = vertices.size();
+            pawnIndexCount = static_cast<GLsizei>(indices.size());
+            addBaseDisc(screenHeight);
+
+            if (marbleMaterial == MarbleMaterial::Streamed) {
+                marbleStream = std::make_unique<VirtualTexture>("marble_full.jpg");
+                if (marbleStream->valid()) {
+                    marbleStream->setUniforms(shaderVariant(pawnShaderFeatures()));
+                } else {
+                    // Missing, or no smaller as tiles than as a plain texture: draw the plain texture.
+                    marbleStream.reset();
+                    marbleMaterial = MarbleMaterial::Texture;
+                }
+            }
+            // The procedural marble needs no texture at all, unless it is being benchmarked against it.
+            packAtlas(screenHeight, marbleMaterial == MarbleMaterial::Texture || benchmarkMarble);
+            pawnToGPU();
 
-        unsigned char* pixelBufBase = nullptr;
+            // Decode and compose off-thread straight into mapped PBOs; draw with flat placeholder colors until resident.
+            loadMaterials();
+        }
 
-        int generatedTextureWidth = 0, generatedTextureHeight = 0, generatedTextureChannels = 0;
+        void streamTextures() {
+            textureStreamer.pump();
+            if (marbleStream) {
+                marbleStream->update();
+            }
 
-        explicit Pawn() {
-            generatePawnMesh(vertices, indices);
-            addFlatSquareQuad();
-            loadTextureFromMemory(marble_jpg, marble_jpg_len, textureMarble, "marble_downsized.h");
-            createTextureBase(pixelBufBase, generatedTextureWidth, generatedTextureHeight, generatedTextureChannels);
-            loadGeneratedTexture(textureBase, pixelBufBase, generatedTextureWidth, generatedTextureHeight);
+            if (startupArena && textureStreamer.allResident()) {
+                constexpr double MiB = 1024.0 * 1024.0;
+                std::cout << "🧹 Released startup arena: " << static_cast<double>(startupArena->usedBytes()) / MiB << " MiB used of "
+                          << static_cast<double>(startupArena->reservedBytes()) / MiB << " MiB in " << startupArena->blockCount() << " blocks\n";
+                startupArena.reset();
+                std::cout << "   → Peak RSS: " << static_cast<double>(peakResidentSetBytes()) / MiB << " MiB\n";
+            }
+        }
 
-            pawnToGPU();
+        void draw(int samples) {
+            glState.bindVertexArray(VAO);
+
+            const auto* baseIndices = reinterpret_cast<const void*>(pawnIndexCount * sizeof(unsigned int));
+            const auto* rimIndices = reinterpret_cast<const void*>((pawnIndexCount + baseIndexCount) * sizeof(unsigned int));
+
+            // Which marble tiles this view needs; read back a few frames later. The base interior only occludes.
+            if (marbleStream) {
+                if (marbleStream->beginFeedback()) {
+                    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                    glDrawElements(GL_TRIANGLES, baseIndexCount, GL_UNSIGNED_INT, baseIndices);
+                    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                    glDrawElements(GL_TRIANGLES, pawnIndexCount, GL_UNSIGNED_INT, nullptr);
+                    marbleStream->endFeedback();
+                }
+                marbleStream->bind(1, 2);
+            }
+
+            // Every other material lives in one array texture; vertices carry their layer.
+            glState.bindTexture(0, GL_TEXTURE_2D_ARRAY, textureMaterials->texture);
+
+            // Opaque pass, blending off and programs that never discard, front to back: the pawn
+            // stands on the base and hides more of it than the other way round.
+            glState.useProgram(shaderVariant(pawnShaderFeatures()));
+            glDrawElements(GL_TRIANGLES, pawnIndexCount, GL_UNSIGNED_INT, nullptr);
+            glState.useProgram(shaderVariant(baseShaderFeatures(false)));
+            glDrawElements(GL_TRIANGLES, baseIndexCount, GL_UNSIGNED_INT, baseIndices);
+
+            // Alpha pass: only the rim. Multisampled, its alpha becomes sample coverage, which needs no
+            // framebuffer reads and no discard; otherwise it is blended over what is already there.
+            const bool alphaToCoverage = samples > 1;
+            glState.useProgram(shaderVariant(baseShaderFeatures(true, alphaToCoverage)));
+            glState.setEnabled(alphaToCoverage ? GL_SAMPLE_ALPHA_TO_COVERAGE : GL_BLEND, true);
+            glDrawElements(GL_TRIANGLES, rimIndexCount, GL_UNSIGNED_INT, rimIndices);
+            glState.setEnabled(alphaToCoverage ? GL_SAMPLE_ALPHA_TO_COVERAGE : GL_BLEND, false);
         }
 
-        void draw() const {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, textureMarble);
+    private:
+        static constexpr int atlasGutter = 8;
+        static constexpr int logoDecalSize = 256;
 
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, textureBase);
+        // Closest the camera gets to the pawn or base, in world units (45° vertical FOV).
+        static constexpr float closestCameraDistance = 1.5f;
 
-            glBindVertexArray(VAO);
-            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
+        static float worldPixelSize(int screenHeight) {
+            return 2.0f * closestCameraDistance * std::tan(glm::radians(22.5f)) / static_cast<float>(screenHeight);
         }
 
-    private:
-        void addFlatSquareQuad() {
-            auto startIndex = static_cast<unsigned int>(vertices.size());
+        [[nodiscard]] int marbleDecodeScaleFor(int screenHeight) const {
+            /*
+             * The largest JPEG DCT scale (1/2, 1/4, 1/8) that still leaves at least a texel per pixel
+             * where the pawn comes closest: around its widest circumference and along its height.
+             */
 
-            glm::vec3 normal = glm::vec3(0.0f, -1.0f, 0.0f);
+            if (marbleDecodeScale != 0) {
+                return marbleDecodeScale;
+            }
 
-            std::vector<Vertex> quadVerts = {
-                { -0.5f, 0.999999f, -0.5f, 0.0f, 0.0f, 1.0f, normal.x, normal.y, normal.z }, // Bottom-left
-                {  0.5f, 0.999999f, -0.5f, 1.0f, 0.0f, 1.0f, normal.x, normal.y, normal.z }, // Bottom-right
-                {  0.5f, 0.999999f,  0.5f, 1.0f, 1.0f, 1.0f, normal.x, normal.y, normal.z }, // Top-right
-                { -0.5f, 0.999999f,  0.5f, 0.0f, 1.0f, 1.0f, normal.x, normal.y, normal.z }, // Top-left
-            };
+            float radius = 0.0f, bottom = 0.0f, top = 0.0f;
+            for (const Vertex& vertex : std::span(vertices).first(pawnVertexCount)) {
+                radius = std::max(radius, std::hypot(vertex.x, vertex.z));
+                bottom = std::min(bottom, vertex.y);
+                top = std::max(top, vertex.y);
+            }
+            const float pixel = worldPixelSize(screenHeight);
+            const float neededWidth = 2.0f * static_cast<float>(M_PI) * radius / pixel;
+            const float neededHeight = (top - bottom) / pixel;
+
+            const Asset marbleJpg = loadAsset("marble.jpg");
+            int width, height, channels;
+            int scale = 1;
+            while (scale < 8 && imageDecodeSize(marbleJpg.data, marbleJpg.size, scale * 2, width, height, channels) &&
+                   static_cast<float>(width) >= neededWidth && static_cast<float>(height) >= neededHeight) {
+                scale *= 2;
+            }
+            return scale;
+        }
 
-            std::vector quadInds = {
-                startIndex,     startIndex + 1, startIndex + 2,
-                startIndex + 2, startIndex + 3, startIndex
+        void packAtlas(int screenHeight, bool withMarble) {
+            /*
+             * Pack the materials into array layers trimmed to what they hold: the composed base, the
+             * carpet tiles and the logo as decals of their own, and the marble `withMarble`. Then remap
+             * the base's and the pawn's UVs into their regions. Only sizes are needed here; the pixels
+             * are decoded and blitted on the worker.
+             */
+
+            int baseWidth, baseHeight, channels;
+            int tileWidth, tileHeight;
+            const Asset carpetPng = loadAsset("carpet_1.png");
+            if (!baseTextureSize(baseWidth, baseHeight, channels) || !carpetPng ||
+                !imageDecodeSize(carpetPng.data, carpetPng.size, 1, tileWidth, tileHeight, channels)) {
+                std::cerr << "❌ Base materials missing from the asset pack, keeping placeholders\n";
+                return;
+            }
+            std::vector<std::array<int, 2>> sizes = {
+                { baseWidth, baseHeight }, { tileWidth, tileHeight }, { tileWidth, tileHeight }, { logoDecalSize, logoDecalSize }
             };
 
-            vertices.insert(vertices.end(), quadVerts.begin(), quadVerts.end());
-            indices.insert(indices.end(), quadInds.begin(), quadInds.end());
+            if (withMarble) {
+                const Asset marbleJpg = loadAsset("marble.jpg");
+                marbleScale = marbleDecodeScaleFor(screenHeight);
+                int marbleWidth, marbleHeight, marbleChannels;
+                if (marbleJpg && imageDecodeSize(marbleJpg.data, marbleJpg.size, marbleScale, marbleWidth, marbleHeight, marbleChannels)) {
+                    std::cout << "🖼️  Marble decoded at 1/" << marbleScale << " scale: " << marbleWidth << "x" << marbleHeight << "\n";
+                    sizes.push_back({ marbleWidth, marbleHeight });
+                } else {
+                    std::cerr << "❌ Marble texture missing from the asset pack, keeping placeholder\n";
+                }
+            }
+
+            GLint maxTextureSize = 0;
+            glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+            std::vector<AtlasRegion> regions;
+            if (!packAtlasTight(sizes, maxTextureSize, atlasGutter, regions, atlas.pageWidth, atlas.pageHeight, atlas.pages)) {
+                std::cerr << "❌ Materials do not fit a " << maxTextureSize << "x" << maxTextureSize << " atlas page, keeping placeholders\n";
+                atlas = {};
+                return;
+            }
+            atlas.base = regions[0];
+            atlas.carpets[0] = regions[1];
+            atlas.carpets[1] = regions[2];
+            atlas.logo = regions[3];
+            atlas.marblePacked = regions.size() > 4;
+            if (atlas.marblePacked) {
+                atlas.marble = regions[4];
+            }
+            std::cout << "🧩 Material atlas: " << atlas.pages << " page(s) of " << atlas.pageWidth << "x" << atlas.pageHeight << "\n";
+
+            auto remap = [](std::span<Vertex> mesh, const AtlasRegion& region) {
+                for (Vertex& vertex : mesh) {
+                    vertex.u = vertex.u * region.uvScale[0] + region.uvOffset[0];
+                    vertex.v = vertex.v * region.uvScale[1] + region.uvOffset[1];
+                    vertex.layer = static_cast<float>(region.page);
+                }
+            };
+            remap(std::span(vertices).subspan(pawnVertexCount), atlas.base);
+            if (atlas.marblePacked) {
+                remap(std::span(vertices).first(pawnVertexCount), atlas.marble);
+            }
         }
 
-        void pawnToGPU() {
-            glGenVertexArrays(1, &VAO);
-            glGenBuffers(1, &VBO);
-            glGenBuffers(1, &EBO);
+        static bool composeLayers(unsigned char* dst, int width, int height, int layers, const AtlasContents& atlas, int marbleScale) {
+            /*
+             * Fill the atlas pages (all RGBA8, `width` x `height`). The base is composed on a second
+             * worker, whose sources also give the carpet tiles, while this one decodes the marble and
+             * rasterizes the logo. Scratch memory comes from the caller's arena on both threads.
+             */
 
-            glBindVertexArray(VAO);
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)), vertices.data(), GL_STATIC_DRAW);
+            if (atlas.pages == 0) {
+                return false;
+            }
 
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(unsigned int)), indices.data(), GL_STATIC_DRAW);
+            struct ComposedBase {
+                BaseSources sources;
+                ScratchVector<unsigned char> texels;
+                bool composed = false;
+            };
+            auto composedBase = std::async(std::launch::async, [&atlas, arena = currentScratchArena()] {
+                ScratchArena::Scope scope(arena);
+                ComposedBase base;
+                if (loadBaseSources(base.sources)) {
+                    base.texels.resize(static_cast<size_t>(atlas.base.width) * atlas.base.height * 4);
+                    base.composed = createTextureBase(base.texels.data(), atlas.base.width, atlas.base.height, base.sources);
+                }
+                return base;
+            });
+
+            // Unused atlas space still feeds the mip chain and the compressor. The gutter keeps the
+            // first log2(atlasGutter) levels clean; below that the marble blends with this fill, so
+            // it is the marble's mean color rather than black, which would darken the distant pawn.
+            ScratchVector<unsigned char> marble;
+            bool marbleDecoded = false;
+            unsigned char fill[4] = { 0, 0, 0, 0 };
+            if (atlas.marblePacked) {
+                const Asset marbleJpg = loadAsset("marble.jpg");
+                const size_t marbleBytes = static_cast<size_t>(atlas.marble.width) * atlas.marble.height * 4;
+                marble.resize(marbleBytes + imageDecodeHeadroom);
+                marbleDecoded = decodeImageInto(marbleJpg.data, marbleJpg.size, marble.data(), marble.size(),
+                                                atlas.marble.width, atlas.marble.height, 4, marbleScale);
+                if (marbleDecoded) {
+                    uint64_t sums[4] = {};
+                    for (size_t i = 0; i < marbleBytes; ++i) {
+                        sums[i % 4] += marble[i];
+                    }
+                    const uint64_t texels = std::max<uint64_t>(1, marbleBytes / 4);
+                    for (int channel = 0; channel < 4; ++channel) {
+                        fill[channel] = static_cast<unsigned char>(sums[channel] / texels);
+                    }
+                }
+            }
+            const size_t pageBytes = static_cast<size_t>(width) * height * 4;
+            for (size_t offset = 0; offset < pageBytes * layers; offset += 4) {
+                memcpy(dst + offset, fill, 4);
+            }
 
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(0));                      // aPos
-            glEnableVertexAttribArray(0);
+            // The marble wraps around the pawn, so its gutter wraps too.
+            if (marbleDecoded) {
+                blitIntoAtlas(dst + pageBytes * atlas.marble.page, width, atlas.marble, atlasGutter, marble.data(), true);
+            }
 
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(3 * sizeof(float)));     // aTexCoord
-            glEnableVertexAttribArray(1);
+            const Asset logoSvg = loadAsset("logo.svg");
+            unsigned char* logo = logoSvg ? rasterizeSVG(logoSvg, atlas.logo.width, atlas.logo.height) : nullptr;
+            const bool logoRasterized = logo != nullptr;
+            if (logoRasterized) {
+                blitIntoAtlas(dst + pageBytes * atlas.logo.page, width, atlas.logo, atlasGutter, logo, false);
+                scratchFree(logo);
+            }
+
+            // The carpet tiles repeat across the base, so theirs wrap; the base and the logo clamp.
+            ComposedBase base = composedBase.get();
+            if (base.composed) {
+                blitIntoAtlas(dst + pageBytes * atlas.base.page, width, atlas.base, atlasGutter, base.texels.data(), false);
+                for (int tile = 0; tile < 2; ++tile) {
+                    blitIntoAtlas(dst + pageBytes * atlas.carpets[tile].page, width, atlas.carpets[tile], atlasGutter, base.sources.carpets[tile], true);
+                }
+            }
+            releaseBaseSources(base.sources);
+            return base.composed && logoRasterized && (marbleDecoded || !atlas.marblePacked);
+        }
 
-            glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(5 * sizeof(float)));     // aTexID
-            glEnableVertexAttribArray(2);
+        void loadMaterials() {
+            constexpr unsigned char basePlaceholder[4] = { 28, 64, 40, 255 };
+            constexpr unsigned char marblePlaceholder[4] = { 214, 210, 202, 255 };
+
+            // Every layer is an atlas page trimmed to the packed extent. Without pages, a single
+            // placeholder layer stands in; its composition fails and it stays flat.
+            StreamedLayout materialLayout{};
+            materialLayout.width = std::max(1, atlas.pageWidth);
+            materialLayout.height = std::max(1, atlas.pageHeight);
+            materialLayout.channels = 4;
+            materialLayout.layers = std::max(1, atlas.pages);
+            materialLayout.array = true;
+            materialLayout.srgbLayers = (1u << materialLayout.layers) - 1;    // Carpet, logo and marble are all sRGB color
+
+            std::vector<unsigned char> placeholders;
+            for (int page = 0; page < materialLayout.layers; ++page) {
+                const bool marbleOnly = atlas.marblePacked && page == atlas.marble.page && page != atlas.base.page;
+                const unsigned char* placeholder = marbleOnly ? marblePlaceholder : basePlaceholder;
+                placeholders.insert(placeholders.end(), placeholder, placeholder + 4);
+            }
 
-            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(6 * sizeof(float)));     // aNormal
-            glEnableVertexAttribArray(3);
+            const bool bc1Supported = GLEW_EXT_texture_compression_s3tc;
+            const bool bc7Supported = GLEW_ARB_texture_compression_bptc;
+            // The array has one block format, and BC1's four colors per block band the photographic
+            // marble; with the marble in the array, `auto` takes BC7 or leaves it all uncompressed.
+            const bool marbleInArray = atlas.marblePacked;
+            const bool autoNeedsBC7 = baseCompression == BaseCompression::Auto && marbleInArray;
+            const bool compress = baseCompression != BaseCompression::Off && (bc1Supported || bc7Supported) && !(autoNeedsBC7 && !bc7Supported);
+
+            if (!compress) {
+                textureMaterials = &textureStreamer.load("materials", placeholders.data(), materialLayout,
+                    [arena = startupArena.get(), atlas = atlas, marbleScale = marbleScale](unsigned char* dst, size_t, StreamedLayout& layout) {
+                        ScratchArena::Scope scope(arena);
+                        return composeLayers(dst, layout.width, layout.height, layout.layers, atlas, marbleScale);
+                    });
+                return;
+            }
 
-            glBindVertexArray(0);
+            // Reserve room for the largest format the worker may pick; it settles the final layout.
+            const bool allowBC7 = bc7Supported && baseCompression != BaseCompression::BC1;
+            const bool forceBC7 = allowBC7 && (baseCompression == BaseCompression::BC7 || !bc1Supported || autoNeedsBC7);
+            materialLayout.levels = mipLevelCount(materialLayout.width, materialLayout.height);
+            materialLayout.bytes = materialLayout.layers *
+                compressedSize(allowBC7 ? BlockFormat::BC7 : BlockFormat::BC1, materialLayout.width, materialLayout.height, materialLayout.levels);
+
+            textureMaterials = &textureStreamer.load("materials", placeholders.data(), materialLayout,
+                [arena = startupArena.get(), allowBC7, forceBC7, atlas = atlas, marbleScale = marbleScale](
+                        unsigned char* dst, size_t, StreamedLayout& layout) {
+                    ScratchArena::Scope scope(arena);
+
+                    // Compression reads the composed texels back, so compose into cached memory, not the mapping.
+                    const size_t texelBytes = static_cast<size_t>(layout.width) * layout.height * 4;
+                    ScratchVector<unsigned char> composed(texelBytes * layout.layers);
+                    if (!composeLayers(composed.data(), layout.width, layout.height, layout.layers, atlas, marbleScale)) {
+                        return false;
+                    }
+
+                    // One block format for the whole array; BC7 as soon as any layer needs it.
+                    BlockFormat format = forceBC7 ? BlockFormat::BC7 : BlockFormat::BC1;
+                    for (int layer = 0; allowBC7 && !forceBC7 && layer < layout.layers; ++layer) {
+                        if (chooseBlockFormat(composed.data() + texelBytes * layer, layout.width, layout.height) == BlockFormat::BC7) {
+                            format = BlockFormat::BC7;
+                        }
+                    }
+
+                    const size_t layerBytes = compressedSize(format, layout.width, layout.height, layout.levels);
+                    for (int layer = 0; layer < layout.layers; ++layer) {
+                        CompressionStats stats;
+                        if (!compressTexture(composed.data() + texelBytes * layer, layout.width, layout.height, format,
+                                             dst + layerBytes * layer, layerBytes, stats)) {
+                            return false;
+                        }
+
+                        std::cout << "✅ Compressed material layer " << layer << ": " << (format == BlockFormat::BC1 ? "BC1" : "BC7") << "\n";
+                        std::cout << "   → Time: " << stats.milliseconds << " ms\n";
+                        std::cout << "   → Size: " << stats.uncompressedBytes / 1024 << " KiB → " << stats.compressedBytes / 1024 << " KiB ("
+                                  << static_cast<double>(stats.uncompressedBytes) / static_cast<double>(stats.compressedBytes) << "×)\n";
+                        std::cout << "   → PSNR: " << stats.psnr << " dB\n";
+                    }
+
+                    layout.compressedFormat = (format == BlockFormat::BC1) ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_BPTC_UNORM;
+                    layout.bytes = layerBytes * layout.layers;
+                    return true;
+                });
         }
 
-        static void loadTextureFromMemory(const unsigned char* data, size_t len, GLuint& textureID, std::string name) {
-            glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+        void addBaseDisc(int screenHeight) {
+            /*
+             * The base as a flat disc: an opaque triangle fan plus a thin rim ring, which is the only
+             * part that needs the anti-aliased alpha mask. The segment count keeps the chord error
+             * under half a pixel at the closest camera distance on a `screenHeight`-line display.
+             */
+
+            const float y = 0.999999f;
+            const glm::vec3 normal = glm::vec3(0.0f, -1.0f, 0.0f);
+
+            // World size of one pixel where the base comes closest to the camera.
+            const float pixel = worldPixelSize(screenHeight);
+
+            // The rim spans the whole smoothstep plus a pixel either way, so the interior is alpha 1 everywhere.
+            const float rimHalfWidth = std::min(std::max(2.0f * baseDiscEdgeWidth, 1.5f * pixel), baseCropHalfExtent - baseDiscRadius);
+            const float innerRadius = baseDiscRadius - rimHalfWidth;
+            const float outerRadius = baseDiscRadius + rimHalfWidth;
+
+            const float maxError = 0.5f * pixel;
+            const int segments = std::clamp(static_cast<int>(std::ceil(M_PI / std::acos(1.0f - maxError / outerRadius))), 16, 512);
+
+            auto addVertex = [&](float x, float z) {
+                // UVs address the cropped base texture, which spans [-baseCropHalfExtent, baseCropHalfExtent];
+                // packAtlas() maps them into its region afterwards.
+                float u = 0.5f + x / (2.0f * baseCropHalfExtent);
+                float v = 0.5f + z / (2.0f * baseCropHalfExtent);
+                vertices.push_back({ x, y, z, u, v, 0.0f, normal.x, normal.y, normal.z });
+                return static_cast<unsigned int>(vertices.size() - 1);
+            };
 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            // Opaque interior: a fan around the center, emitted as triangles.
+            unsigned int center = addVertex(0.0f, 0.0f);
+            unsigned int interiorStart = static_cast<unsigned int>(vertices.size());
+            for (int i = 0; i < segments; ++i) {
+                float theta = 2.0f * static_cast<float>(M_PI) * static_cast<float>(i) / static_cast<float>(segments);
+                addVertex(innerRadius * std::cos(theta), innerRadius * std::sin(theta));
+            }
+            for (int i = 0; i < segments; ++i) {
+                indices.insert(indices.end(), { center, interiorStart + i, interiorStart + (i + 1) % segments });
+            }
+            baseIndexCount = static_cast<GLsizei>(indices.size()) - pawnIndexCount;
+
+            // Rim ring: inner and outer vertices per segment, masked in the fragment shader.
+            unsigned int rimStart = static_cast<unsigned int>(vertices.size());
+            for (int i = 0; i < segments; ++i) {
+                float theta = 2.0f * static_cast<float>(M_PI) * static_cast<float>(i) / static_cast<float>(segments);
+                addVertex(innerRadius * std::cos(theta), innerRadius * std::sin(theta));
+                addVertex(outerRadius * std::cos(theta), outerRadius * std::sin(theta));
+            }
+            for (int i = 0; i < segments; ++i) {
+                unsigned int in0 = rimStart + 2 * i, out0 = in0 + 1;
+                unsigned int in1 = rimStart + 2 * ((i + 1) % segments), out1 = in1 + 1;
+                indices.insert(indices.end(), { in0, out0, in1, in1, out0, out1 });
+            }
+            rimIndexCount = static_cast<GLsizei>(indices.size()) - pawnIndexCount - baseIndexCount;
+        }
 
-            int width, height, nrChannels;
-            stbi_set_flip_vertically_on_load(true);
-            unsigned char* imgData = stbi_load_from_memory(data, static_cast<int>(len), &width, &height, &nrChannels, 0);
+        void uploadFloatVertices() {
+            VBO = glState.createBuffer(static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)), vertices.data(), 0);
+            glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
-            if (!imgData) {
-                std::cerr << "❌ stbi_load_from_memory failed\n";
-                return;
-            }
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(0));                      // aPos
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(3 * sizeof(float)));     // aTexCoord
+            glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(5 * sizeof(float)));     // aLayer
+            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(6 * sizeof(float)));     // aNormal
+        }
 
-            GLenum format = (nrChannels == 4) ? GL_RGBA :
-                            (nrChannels == 3) ? GL_RGB :
-                            (nrChannels == 1) ? GL_RED : 0;
+        void uploadQuantizedVertices() {
+            /*
+             * Positions become signed normalized 16-bit relative to the mesh bounds, which the
+             * QUANTIZED_VERTICES variants undo with Material.positionScale/positionOffset; UVs are
+             * already in [0, 1] and normals unit length, so they need no scale of their own.
+             */
+
+            glm::vec3 low(std::numeric_limits<float>::max()), high(std::numeric_limits<float>::lowest());
+            for (const Vertex& vertex : vertices) {
+                low = glm::min(low, glm::vec3(vertex.x, vertex.y, vertex.z));
+                high = glm::max(high, glm::vec3(vertex.x, vertex.y, vertex.z));
+            }
+            const glm::vec3 center = 0.5f * (low + high);
+            const glm::vec3 halfExtent = glm::max(0.5f * (high - low), glm::vec3(1e-6f));
+
+            auto snorm16 = [](float value) { return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f)); };
+            auto unorm16 = [](float value) { return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f)); };
+            auto snorm10 = [](float value) { return static_cast<uint32_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f)) & 0x3FFu; };
+
+            std::vector<QuantizedVertex> packed;
+            packed.reserve(vertices.size());
+            for (const Vertex& vertex : vertices) {
+                const glm::vec3 position = (glm::vec3(vertex.x, vertex.y, vertex.z) - center) / halfExtent;
+                packed.push_back({
+                    { snorm16(position.x), snorm16(position.y), snorm16(position.z) },
+                    static_cast<uint16_t>(vertex.layer),
+                    { unorm16(vertex.u), unorm16(vertex.v) },
+                    snorm10(vertex.nx) | (snorm10(vertex.ny) << 10) | (snorm10(vertex.nz) << 20)
+                });
+            }
+            VBO = glState.createBuffer(static_cast<GLsizeiptr>(packed.size() * sizeof(QuantizedVertex)), packed.data(), 0);
+            glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
-            GLenum internalFormat = (format == GL_RGBA) ? GL_RGBA8 :
-                                     (format == GL_RGB) ? GL_RGB8 :
-                                     (format == GL_RED) ? GL_RED : 0;
+            glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, sizeof(QuantizedVertex), reinterpret_cast<void*>(offsetof(QuantizedVertex, position)));
+            glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(QuantizedVertex), reinterpret_cast<void*>(offsetof(QuantizedVertex, uv)));
+            glVertexAttribPointer(2, 1, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(QuantizedVertex), reinterpret_cast<void*>(offsetof(QuantizedVertex, layer)));
+            glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(QuantizedVertex), reinterpret_cast<void*>(offsetof(QuantizedVertex, normal)));
 
-            std::cout << "✅ Loaded texture: " << name << "\n";
-            std::cout << "   → Dimensions: " << width << "x" << height << "\n";
-            std::cout << "   → Channels: " << nrChannels << "\n";
-            std::cout << "   → Format: " << ((format == GL_RGB) ? "RGB" :
-                                             (format == GL_RGBA) ? "RGBA" :
-                                             (format == GL_RED) ? "RED" : "Unknown") << "\n";
+            MaterialUniforms material = currentMaterialUniforms();
+            material.positionScale = glm::vec4(halfExtent, 0.0f);
+            material.positionOffset = glm::vec4(center, 0.0f);
+            updateMaterialUniforms(material);
 
-            glTexImage2D(GL_TEXTURE_2D, 0, (GLint) internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, imgData);
-            glGenerateMipmap(GL_TEXTURE_2D);
-            stbi_image_free(imgData);
+            std::cout << "🧩 Quantized vertices: " << sizeof(QuantizedVertex) << " bytes each instead of " << sizeof(Vertex) << "\n";
         }
 
-        static void loadGeneratedTexture(GLuint& textureID, const unsigned char* pixelData, int width, int height) {
-            glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+        void pawnToGPU() {
+            glGenVertexArrays(1, &VAO);
+            glState.bindVertexArray(VAO);
+            if (vertexFormat == VertexFormat::Quantized) {
+                uploadQuantizedVertices();
+            } else {
+                uploadFloatVertices();
+            }
 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            EBO = glState.createBuffer(static_cast<GLsizeiptr>(indices.size() * sizeof(unsigned int)), indices.data(), 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixelData);
-            glGenerateMipmap(GL_TEXTURE_2D);
+            for (GLuint attribute = 0; attribute < 4; ++attribute) {
+                glEnableVertexAttribArray(attribute);
+            }
 
-            std::cout << "✅ Loaded generated texture:\n";
-            std::cout << "   → Dimensions: " << width << "x" << height << "\n";
-            std::cout << "   → Channels: 4\n";
-            std::cout << "   → Format: RGBA\n";
+            glState.bindVertexArray(0);
         }
 };
 
 
-int main() {
-    static bool fWasPressed = false;
+int main(int argc, char** argv) {
+    parseOptions(argc, argv);
+    if (!openAssetPack(assetPackPath)) {
+        std::cerr << "❌ No usable asset pack\n";
+        return EXIT_FAILURE;
+    }
+
     GLFWmonitor* monitor = nullptr;
     const GLFWvidmode* mode = nullptr;
     GLFWwindow* window = initWindow(&monitor, &mode);
 
     setupShaders();
 
-    Pawn pawn{};
+    Pawn pawn{mode ? mode->height : 1080};
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    // Blending stays off except for the base rim's alpha pass, see Pawn::draw().
+    glState.setEnabled(GL_DEPTH_TEST, true);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    float position_x = 0.0f;
+    bool firstFrame = true;
+
+    FramePacer pacer(targetFps, unfocusedFps);
+    Simulation simulation(simulationRate, unfocusedFps);
+    simulation.start();
+
+    // Without an explicit budget, leave a sixth of the frame for the upscale, the swap and the CPU.
+    const double frameRate = (targetFps > 0.0) ? targetFps : (mode && mode->refreshRate > 0) ? mode->refreshRate : 60.0;
+    DynamicResolution resolution(frameBudgetMs > 0.0 ? frameBudgetMs : 1000.0 / frameRate * 5.0 / 6.0, renderScale, upscaleFilter, antiAliasing, msaaSamples);
+    FrameLatency latency(framesInFlight, reportLatency);
 
     while (!glfwWindowShouldClose(window)) {
-        if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS) {
-            if (!fWasPressed) {
-                toggleFullscreen(window, monitor, mode, isFullscreen);
-                fWasPressed = true;
-            }
-        } else {
-            fWasPressed = false;
+        // Processes input too (see setupGLFW.cpp); nothing is drawn while the window is hidden.
+        simulation.setPacing(pacingModeFor(window));
+        if (!pacer.waitForFrame(window)) {
+            continue;
         }
 
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+        pawn.streamTextures();
+
+        if ((benchmarkMarble || benchmarkMipmaps) && pawn.textureStreamer.allResident()) {
+            if (benchmarkMarble) {
+                runMarbleBenchmark(pawn.textureMaterials->texture, static_cast<float>(pawn.atlas.marble.page), pawn.atlas.marble);
+            }
+            if (benchmarkMipmaps) {
+                const StreamedLayout& layout = pawn.textureMaterials->layout;
+                if (layout.compressedFormat) {
+                    std::cerr << "❌ --benchmark-mipmaps needs --base-compression=off; block-compressed textures carry their own mip chain\n";
+                } else {
+                    runMipmapBenchmark(pawn.textureMaterials->texture, layout.target(), layout.width, layout.height, layout.layers, layout.srgbLayers);
+                }
+            }
             glfwSetWindowShouldClose(window, GL_TRUE);
+            continue;
+        }
+
+        // Bounded, the wait for the GPU comes first and input is read again after it, so the frame
+        // starts from the freshest input and clock rather than what was current before the wait.
+        latency.beginFrame();
+        if (latency.bounded()) {
+            glfwPollEvents();
         }
 
-        position_x = rotateAndSetLights(position_x);
+        frameDataRing().beginFrame();
+        glState.beginFrame();
 
-        pawn.draw();
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        resolution.begin(framebufferWidth, framebufferHeight);
+
+        resolution.setSceneTransform(rotateAndSetLights(simulation.sample(glfwGetTime()), resolution.aspect(), resolution.jitter()));
+
+        pawn.draw(resolution.samples());
+
+        resolution.end();
+        frameDataRing().endFrame();
 
         glfwSwapBuffers(window);
-        glfwWaitEventsTimeout(0.01);
+        latency.endFrame();
+
+        if (firstFrame) {
+            firstFrame = false;
+            std::cout << "⏱️  Time to first frame: " << millisecondsSinceStartup() << " ms\n";
+        }
     }
+    simulation.stop();
+    pacer.report();
+    simulation.report();
+    latency.report();
+    resolution.report();
+    std::cout << "   → Frame data ring: " << (frameDataRing().persistent() ? "persistently mapped" : "staged (no GL_ARB_buffer_storage)")
+              << ", " << frameDataRing().stalls() << " frames waited for the GPU\n";
+    glState.report();
+
+    // Everything holding GL objects lets go of them while the context is still current.
+    pawn.textureStreamer.shutdown();
+    resolution.release();
+    latency.release();
+    releaseFrameDataRing();
 
     glfwDestroyWindow(window);
     glfwTerminate();
@@ -0,0 +1,125 @@
+#include "marbleBenchmark.h"
+#include "shaders.h"
+#include "glState.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+
+static GLuint createBenchmarkProgram(const std::string& fragmentBody, bool procedural) {
+    const char* vertexShaderSource = R"(
+        #version 330 core
+        out vec2 uv;
+
+        // Full-screen triangle from gl_VertexID, no vertex buffer needed
+        void main() {
+            vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            uv = p;
+            gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+    std::string fragmentShaderSource = "#version 330 core\n";
+    if (procedural) {
+        fragmentShaderSource += proceduralMarbleGLSL;
+    }
+    fragmentShaderSource += R"(
+        in vec2 uv;
+        out vec4 FragColor;
+        uniform sampler2DArray marble;
+        uniform float marbleLayer;
+        uniform vec4 marbleRegion;  // UV scale, UV offset within the atlas page
+    )";
+    fragmentShaderSource += fragmentBody;
+
+    GLuint vs = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource.c_str());
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    return program;
+}
+
+static double timePasses(GLuint program, int passes) {
+    glUseProgram(program);
+
+    // Warm up: the first draw with a fresh program often includes deferred compilation.
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glFinish();
+
+    GLuint query;
+    glGenQueries(1, &query);
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    for (int i = 0; i < passes; ++i) {
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+    glDeleteQueries(1, &query);
+    return static_cast<double>(nanoseconds);
+}
+
+void runMarbleBenchmark(GLuint materialTexture, float marbleLayer, const AtlasRegion& marbleRegion, int size, int passes) {
+    GLint previousViewport[4];
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    GLuint fbo, color, vao;
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glViewport(0, 0, size, size);
+    glDisable(GL_DEPTH_TEST);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, materialTexture);
+
+    // The texture variant repeats the marble a few times so it samples a realistic mip, like the pawn does.
+    GLuint constantProgram = createBenchmarkProgram("void main() { FragColor = vec4(uv, 0.5, 1.0); }", false);
+    GLuint textureProgram = createBenchmarkProgram("void main() { FragColor = texture(marble, vec3(fract(uv * 3.0) * marbleRegion.xy + marbleRegion.zw, marbleLayer)); }", false);
+    glUseProgram(textureProgram);
+    glUniform1f(glGetUniformLocation(textureProgram, "marbleLayer"), marbleLayer);
+    glUniform4f(glGetUniformLocation(textureProgram, "marbleRegion"), marbleRegion.uvScale[0], marbleRegion.uvScale[1],
+                marbleRegion.uvOffset[0], marbleRegion.uvOffset[1]);
+    GLuint proceduralProgram = createBenchmarkProgram(
+        "void main() { vec3 p = vec3(uv.x * 0.7 - 0.35, uv.y, 0.1);"
+        "              FragColor = vec4(proceduralMarble(p, marbleFootprint(p)), 1.0); }", true);
+
+    const double fragments = static_cast<double>(size) * size * passes;
+    const double constantNs = timePasses(constantProgram, passes) / fragments;
+    const double textureNs = timePasses(textureProgram, passes) / fragments;
+    const double proceduralNs = timePasses(proceduralProgram, passes) / fragments;
+
+    std::cout << "⏱️  Marble benchmark (" << size << "x" << size << ", " << passes << " passes, GPU time per fragment):\n"
+              << std::fixed << std::setprecision(4)
+              << "   → Constant color:   " << constantNs << " ns\n"
+              << "   → Texture fetch:    " << textureNs << " ns (+" << textureNs - constantNs << " ns)\n"
+              << "   → Procedural noise: " << proceduralNs << " ns (+" << proceduralNs - constantNs << " ns)\n"
+              << "   → Procedural / texture marginal cost: "
+              << (proceduralNs - constantNs) / std::max(textureNs - constantNs, 1e-6) << "×\n"
+              << std::defaultfloat;
+
+    glDeleteProgram(constantProgram);
+    glDeleteProgram(textureProgram);
+    glDeleteProgram(proceduralProgram);
+    glDeleteVertexArrays(1, &vao);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glEnable(GL_DEPTH_TEST);
+    // The measurement binds directly; the cache must not trust what it remembers from before.
+    glState.invalidate();
+}
@@ -0,0 +1,20 @@
+#ifndef MARBLEBENCHMARK_H
+#define MARBLEBENCHMARK_H
+#include <GL/glew.h>
+#include "textureAtlas.h"
+
+void runMarbleBenchmark(
+    /*
+     * Renders a full-screen pass into an offscreen target with three fragment shaders:
+     * a constant color (fixed cost), the marble texture fetch and the procedural marble.
+     * Prints GPU time per fragment (GL_TIME_ELAPSED) for each, and the difference to the baseline.
+     */
+
+    GLuint materialTexture,     // GL_TEXTURE_2D_ARRAY holding the marble
+    float marbleLayer,
+    const AtlasRegion& marbleRegion,
+    int size = 1024,
+    int passes = 50
+);
+
+#endif //MARBLEBENCHMARK_H
@@ -0,0 +1,283 @@
+#include "mipGenerator.h"
+#include "programCache.h"
+#include "glState.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Level 6 of the largest supported texture must fit the final 64x64 tile: up to 4095 texels, 12 levels.
+static constexpr int maxLevels = 12;
+
+static const char* const mipComputeSource = R"(
+        layout(local_size_x = 256) in;
+
+        uniform sampler2DArray source;      // Level 0
+        uniform ivec2 baseSize;
+        uniform int levelCount;
+        uniform int levelOffsets[12];       // First texel of each level within a layer, in uints
+        uniform int layerStride;
+        uniform uint srgbLayers;
+
+        // Levels 1.. of every layer as packed RGBA8; copied into the texture afterwards.
+        layout(std430) coherent buffer Mips { uint texels[]; };
+        layout(std430) coherent buffer Counters { uint finishedGroups[]; };
+
+        shared vec4 tile[256];              // 16x16 partial results, premultiplied and linear
+        shared bool lastGroup;
+
+        int layer;
+        bool srgb;
+
+        vec3 toLinear(vec3 c) { return mix(c / 12.92, pow((c + 0.055) / 1.055, vec3(2.4)), step(vec3(0.04045), c)); }
+        vec3 toSrgb(vec3 c) { return mix(c * 12.92, 1.055 * pow(c, vec3(1.0 / 2.4)) - 0.055, step(vec3(0.0031308), c)); }
+
+        // Filter in premultiplied alpha, and in linear light for sRGB layers.
+        vec4 decode(vec4 c) {
+            if (srgb) c.rgb = toLinear(c.rgb);
+            return vec4(c.rgb * c.a, c.a);
+        }
+
+        vec4 encode(vec4 c) {
+            vec3 rgb = c.a > 0.0 ? c.rgb / c.a : vec3(0.0);
+            if (srgb) rgb = toSrgb(rgb);
+            return vec4(rgb, c.a);
+        }
+
+        uint pack(vec4 c) {
+            uvec4 b = uvec4(round(clamp(c, 0.0, 1.0) * 255.0));
+            return b.r | (b.g << 8) | (b.b << 16) | (b.a << 24);
+        }
+
+        vec4 unpack(uint v) {
+            return vec4(uvec4(v, v >> 8, v >> 16, v >> 24) & 0xFFu) / 255.0;
+        }
+
+        ivec2 levelSize(int level) {
+            return max(baseSize >> level, ivec2(1));
+        }
+
+        vec4 load(int level, ivec2 p) {
+            ivec2 size = levelSize(level);
+            p = min(p, size - 1);
+            if (level == 0) return decode(texelFetch(source, ivec3(p, layer), 0));
+            return decode(unpack(texels[layer * layerStride + levelOffsets[level] + p.y * size.x + p.x]));
+        }
+
+        // Texels past a level's edge are computed from clamped reads but never stored or used for stored ones.
+        void store(int level, ivec2 p, vec4 c) {
+            ivec2 size = levelSize(level);
+            if (level < levelCount && all(lessThan(p, size)))
+                texels[layer * layerStride + levelOffsets[level] + p.y * size.x + p.x] = pack(encode(c));
+        }
+
+        // Reduce the 64x64 texels of `level` at `origin` into levels + 1 to + 6.
+        void reduceTile(int level, ivec2 origin) {
+            ivec2 t = ivec2(int(gl_LocalInvocationIndex % 16u), int(gl_LocalInvocationIndex / 16u));
+            ivec2 p = origin + t * 4;
+
+            // Each thread: a 4x4 footprint, 2x2 at level + 1, one texel at level + 2.
+            vec4 sum = vec4(0.0);
+            for (int y = 0; y < 2; ++y) {
+                for (int x = 0; x < 2; ++x) {
+                    ivec2 q = p + ivec2(x, y) * 2;
+                    vec4 c = 0.25 * (load(level, q) + load(level, q + ivec2(1, 0)) + load(level, q + ivec2(0, 1)) + load(level, q + ivec2(1, 1)));
+                    store(level + 1, (origin >> 1) + t * 2 + ivec2(x, y), c);
+                    sum += c;
+                }
+            }
+            sum *= 0.25;
+            store(level + 2, (origin >> 2) + t, sum);
+            tile[t.y * 16 + t.x] = sum;
+
+            // The rest in shared memory: 8x8, 4x4, 2x2, 1x1.
+            for (int k = 1; k <= 4; ++k) {
+                memoryBarrierShared();
+                barrier();
+                int n = 16 >> k;
+                bool active = t.x < n && t.y < n;
+                vec4 c = vec4(0.0);
+                if (active) {
+                    int i = t.y * 2 * 16 + t.x * 2;
+                    c = 0.25 * (tile[i] + tile[i + 1] + tile[i + 16] + tile[i + 17]);
+                }
+                memoryBarrierShared();
+                barrier();
+                if (active) {
+                    tile[t.y * 16 + t.x] = c;
+                    store(level + 2 + k, (origin >> (2 + k)) + t, c);
+                }
+            }
+        }
+
+        void main() {
+            layer = int(gl_WorkGroupID.z);
+            srgb = ((srgbLayers >> uint(layer)) & 1u) != 0u;
+
+            reduceTile(0, ivec2(gl_WorkGroupID.xy) * 64);
+            if (levelCount <= 7) return;
+
+            // Publish this group's texels, then let the layer's last group finish the chain from level 6.
+            memoryBarrierBuffer();
+            barrier();
+            if (gl_LocalInvocationIndex == 0u) {
+                uint groups = gl_NumWorkGroups.x * gl_NumWorkGroups.y;
+                lastGroup = atomicAdd(finishedGroups[layer], 1u) == groups - 1u;
+            }
+            memoryBarrierShared();
+            barrier();
+            if (lastGroup) {
+                memoryBarrierBuffer();
+                reduceTile(6, ivec2(0));
+            }
+        }
+    )";
+
+static GLuint mipProgram = 0;
+static GLuint mipBuffers[2] = { 0, 0 };    // Mips, Counters
+
+bool computeMipmapsSupported() {
+    return GLEW_VERSION_4_3 || (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_program_interface_query);
+}
+
+static bool createMipProgram() {
+    std::string source = GLEW_VERSION_4_3 ? "#version 430 core\n"
+                                          : "#version 330 core\n"
+                                            "#extension GL_ARB_compute_shader : require\n"
+                                            "#extension GL_ARB_shader_storage_buffer_object : require\n";
+    source += mipComputeSource;
+
+    mipProgram = beginProgram({ { GL_COMPUTE_SHADER, source } });
+    if (!finishProgram(mipProgram)) {
+        std::cerr << "❌ Mip compute shader unusable, falling back to glGenerateMipmap\n";
+        glDeleteProgram(mipProgram);
+        mipProgram = 0;
+        return false;
+    }
+
+    glShaderStorageBlockBinding(mipProgram, glGetProgramResourceIndex(mipProgram, GL_SHADER_STORAGE_BLOCK, "Mips"), 0);
+    glShaderStorageBlockBinding(mipProgram, glGetProgramResourceIndex(mipProgram, GL_SHADER_STORAGE_BLOCK, "Counters"), 1);
+    glGenBuffers(2, mipBuffers);
+    return true;
+}
+
+bool generateMipmapsCompute(GLuint texture, GLenum target, int width, int height, int layers, uint32_t srgbLayers) {
+    if (target != GL_TEXTURE_2D_ARRAY || !computeMipmapsSupported() || layers > 32) {
+        return false;
+    }
+
+    int levels = 1;
+    while ((std::max(width, height) >> levels) > 0) {
+        ++levels;
+    }
+    if (levels > maxLevels) {
+        std::cerr << "❌ " << width << "x" << height << " is too large for compute mipmaps (" << maxLevels
+                  << " levels at most), falling back to glGenerateMipmap\n";
+        return false;
+    }
+    if (!mipProgram && !createMipProgram()) {
+        return false;
+    }
+
+    // Pack levels 1.. of a layer back to back; layers follow each other.
+    GLint levelOffsets[maxLevels] = {};
+    int layerStride = 0;
+    for (int level = 1; level < levels; ++level) {
+        levelOffsets[level] = layerStride;
+        layerStride += std::max(1, width >> level) * std::max(1, height >> level);
+    }
+
+    GLint previousUnpack;
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &previousUnpack);
+
+    // Allocate the levels once; regenerating (e.g. in the benchmark) only rewrites them.
+    glState.bindTextureForEdit(target, texture);
+    GLint lastLevelWidth = 0;
+    glGetTexLevelParameteriv(target, levels - 1, GL_TEXTURE_WIDTH, &lastLevelWidth);
+    if (lastLevelWidth == 0) {
+        for (int level = 1; level < levels; ++level) {
+            glTexImage3D(target, level, GL_RGBA8, std::max(1, width >> level), std::max(1, height >> level), layers, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mipBuffers[0]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(layerStride) * layers * 4, nullptr, GL_STREAM_COPY);
+    const std::vector<GLuint> counters(layers, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mipBuffers[1]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(layers * sizeof(GLuint)), counters.data(), GL_STREAM_COPY);
+
+    glState.useProgram(mipProgram);
+    glUniform1i(glGetUniformLocation(mipProgram, "source"), 0);
+    glUniform2i(glGetUniformLocation(mipProgram, "baseSize"), width, height);
+    glUniform1i(glGetUniformLocation(mipProgram, "levelCount"), levels);
+    glUniform1iv(glGetUniformLocation(mipProgram, "levelOffsets"), maxLevels, levelOffsets);
+    glUniform1i(glGetUniformLocation(mipProgram, "layerStride"), layerStride);
+    glUniform1ui(glGetUniformLocation(mipProgram, "srgbLayers"), srgbLayers);
+
+    glState.bindTexture(0, target, texture);
+    glDispatchCompute((width + 63) / 64, (height + 63) / 64, layers);
+
+    // Copy the chain into the texture straight from the storage buffer.
+    glMemoryBarrier(GL_PIXEL_BUFFER_BARRIER_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mipBuffers[0]);
+    glState.bindTextureForEdit(target, texture);
+    for (int layer = 0; layer < layers; ++layer) {
+        for (int level = 1; level < levels; ++level) {
+            const size_t offset = (static_cast<size_t>(layer) * layerStride + levelOffsets[level]) * 4;
+            glTexSubImage3D(target, level, 0, 0, layer, std::max(1, width >> level), std::max(1, height >> level), 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<void*>(offset));
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, static_cast<GLuint>(previousUnpack));
+    return true;
+}
+
+template <typename Generate>
+static void timeMipmaps(const char* label, int iterations, Generate generate) {
+    // Warm up: first use may compile shaders or allocate levels.
+    generate();
+    glFinish();
+
+    GLuint query;
+    glGenQueries(1, &query);
+    auto start = std::chrono::steady_clock::now();
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    for (int i = 0; i < iterations; ++i) {
+        generate();
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    glFinish();
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+    glDeleteQueries(1, &query);
+
+    std::cout << "   → " << label << static_cast<double>(nanoseconds) / 1e6 / iterations << " ms GPU, " << wallMs << " ms wall\n";
+}
+
+void runMipmapBenchmark(GLuint texture, GLenum target, int width, int height, int layers, uint32_t srgbLayers, int iterations) {
+    std::cout << "⏱️  Mipmap benchmark (" << width << "x" << height << " × " << layers << " layers, " << iterations << " runs, per run):\n"
+              << std::fixed << std::setprecision(3);
+
+    timeMipmaps("glGenerateMipmap:       ", iterations, [&] {
+        glState.bindTextureForEdit(target, texture);
+        glGenerateMipmap(target);
+    });
+
+    if (computeMipmapsSupported()) {
+        timeMipmaps("Compute (single pass):  ", iterations, [&] {
+            generateMipmapsCompute(texture, target, width, height, layers, srgbLayers);
+        });
+    } else {
+        std::cout << "   → Compute (single pass):  unsupported by this context\n";
+    }
+    std::cout << std::defaultfloat;
+}
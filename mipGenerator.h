@@ -0,0 +1,43 @@
+#ifndef MIPGENERATOR_H
+#define MIPGENERATOR_H
+#include <GL/glew.h>
+#include <cstdint>
+
+// Compute shaders and storage buffers: core in GL 4.3, extensions on older contexts, absent on macOS.
+bool computeMipmapsSupported();
+
+bool generateMipmapsCompute(
+    /*
+     * Build the full mip chain of an RGBA8 GL_TEXTURE_2D_ARRAY from level 0 in a single dispatch.
+     * Every workgroup reduces a 64x64 tile through six levels in shared memory; the last group of
+     * each layer to finish reduces the resulting level 6 through the rest of the chain.
+     * Filtering uses premultiplied alpha, so transparent texels don't bleed their color, and
+     * linear light for the layers set in `srgbLayers`. Allocates levels 1.. and sets MAX_LEVEL.
+     * Returns false (leaving the texture alone) when unsupported; fall back to glGenerateMipmap.
+     */
+
+    GLuint texture,
+    GLenum target,
+    int width,
+    int height,
+    int layers,
+    uint32_t srgbLayers
+);
+
+void runMipmapBenchmark(
+    /*
+     * Times glGenerateMipmap against generateMipmapsCompute on `texture`, both as GPU time
+     * (GL_TIME_ELAPSED) and as wall time to completion, which is what counts where the driver
+     * builds mipmaps on the CPU. Leaves the compute-generated chain in place.
+     */
+
+    GLuint texture,
+    GLenum target,
+    int width,
+    int height,
+    int layers,
+    uint32_t srgbLayers,
+    int iterations = 20
+);
+
+#endif //MIPGENERATOR_H
@@ -0,0 +1,145 @@
+#include "options.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --base-compression=off|auto|bc1|bc7   Block-compress the generated base texture (default: auto)\n"
+              << "  --marble=texture|procedural|streamed  Marble material for the pawn body; streamed pays off for sources larger than its pool (default: texture)\n"
+              << "  --marble-scale=auto|1|2|4|8           Decode the marble JPEG at 1/N resolution (default: auto)\n"
+              << "  --benchmark-marble                    Compare procedural marble against the texture fetch and exit\n"
+              << "  --mipmaps=compute|driver              Generate texture mipmaps in a compute shader or with the driver (default: compute)\n"
+              << "  --benchmark-mipmaps                   Compare compute mipmap generation against the driver's and exit\n"
+              << "  --shader-cache=on|off                 Reuse linked shader binaries from earlier runs (default: on)\n"
+              << "  --vertex-format=float|quantized       Upload the mesh with float or 16-bit/10-bit attributes (default: float)\n"
+              << "  --vsync=on|off                        Wait for the display's refresh on swap (default: on)\n"
+              << "  --fps=N                               Cap the frame rate while focused; 0 for none (default: 0)\n"
+              << "  --unfocused-fps=N                     Cap the frame rate while unfocused; 0 for none (default: 10)\n"
+              << "  --render-scale=auto|S                 Draw at S (0.25-2) times the window's resolution, or adapt it (default: auto)\n"
+              << "  --frame-budget=MS                     GPU time per frame the adaptive scale aims for (default: from the frame rate)\n"
+              << "  --upscale=bilinear|sharpen            Filter from the render scale to the window (default: bilinear)\n"
+              << "  --aa=off|msaa|fxaa|taa                Anti-aliasing of the scene (default: off)\n"
+              << "  --msaa=0|2|4|8                        Samples per pixel with --aa=msaa, which alone it selects; the base rim then uses alpha-to-coverage (default: 4)\n"
+              << "  --sim-rate=HZ                         Ticks per second of the animation thread (default: 120)\n"
+              << "  --frames-in-flight=0|1|2              Cap frames queued for the GPU for lower latency; 0 for the driver's (default: 0)\n"
+              << "  --report-latency                      Measure input-to-GPU latency even without --frames-in-flight\n"
+              << "  --assets=PATH                         Load assets from PATH instead of the pack built into the binary\n";
+}
+
+static double parseNumber(std::string_view arg, std::string_view prefix, double min, double max) {
+    const std::string value(arg.substr(prefix.size()));
+    char* end = nullptr;
+    const double number = std::strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0' || number < min || number > max) {
+        std::cerr << "❌ Out of range (" << min << " to " << max << "): " << arg << "\n";
+        exit(EXIT_FAILURE);
+    }
+    return number;
+}
+
+void parseOptions(int argc, char** argv) {
+    bool antiAliasingGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+
+        if (arg == "--base-compression=off") {
+            baseCompression = BaseCompression::Off;
+        } else if (arg == "--base-compression=auto") {
+            baseCompression = BaseCompression::Auto;
+        } else if (arg == "--base-compression=bc1") {
+            baseCompression = BaseCompression::BC1;
+        } else if (arg == "--base-compression=bc7") {
+            baseCompression = BaseCompression::BC7;
+        } else if (arg == "--marble=texture") {
+            marbleMaterial = MarbleMaterial::Texture;
+        } else if (arg == "--marble=procedural") {
+            marbleMaterial = MarbleMaterial::Procedural;
+        } else if (arg == "--marble=streamed") {
+            marbleMaterial = MarbleMaterial::Streamed;
+        } else if (arg == "--marble-scale=auto") {
+            marbleDecodeScale = 0;
+        } else if (arg == "--marble-scale=1" || arg == "--marble-scale=2" || arg == "--marble-scale=4" || arg == "--marble-scale=8") {
+            marbleDecodeScale = arg.back() - '0';
+        } else if (arg == "--benchmark-marble") {
+            benchmarkMarble = true;
+        } else if (arg == "--mipmaps=compute") {
+            mipmapGeneration = MipmapGeneration::Compute;
+        } else if (arg == "--mipmaps=driver") {
+            mipmapGeneration = MipmapGeneration::Driver;
+        } else if (arg == "--benchmark-mipmaps") {
+            benchmarkMipmaps = true;
+        } else if (arg == "--shader-cache=on") {
+            shaderCache = true;
+        } else if (arg == "--shader-cache=off") {
+            shaderCache = false;
+        } else if (arg == "--vertex-format=float") {
+            vertexFormat = VertexFormat::Float;
+        } else if (arg == "--vertex-format=quantized") {
+            vertexFormat = VertexFormat::Quantized;
+        } else if (arg == "--vsync=on") {
+            vsync = true;
+        } else if (arg == "--vsync=off") {
+            vsync = false;
+        } else if (arg.starts_with("--fps=")) {
+            targetFps = parseNumber(arg, "--fps=", 0.0, 1000.0);
+        } else if (arg.starts_with("--unfocused-fps=")) {
+            unfocusedFps = parseNumber(arg, "--unfocused-fps=", 0.0, 1000.0);
+        } else if (arg == "--render-scale=auto") {
+            renderScale = 0.0f;
+        } else if (arg.starts_with("--render-scale=")) {
+            renderScale = static_cast<float>(parseNumber(arg, "--render-scale=", 0.25, 2.0));
+        } else if (arg.starts_with("--frame-budget=")) {
+            frameBudgetMs = parseNumber(arg, "--frame-budget=", 0.1, 1000.0);
+        } else if (arg == "--upscale=bilinear") {
+            upscaleFilter = UpscaleFilter::Bilinear;
+        } else if (arg == "--upscale=sharpen") {
+            upscaleFilter = UpscaleFilter::Sharpen;
+        } else if (arg.starts_with("--aa=")) {
+            antiAliasingGiven = true;
+            if (arg == "--aa=off") {
+                antiAliasing = AntiAliasing::Off;
+            } else if (arg == "--aa=msaa") {
+                antiAliasing = AntiAliasing::Msaa;
+            } else if (arg == "--aa=fxaa") {
+                antiAliasing = AntiAliasing::Fxaa;
+            } else if (arg == "--aa=taa") {
+                antiAliasing = AntiAliasing::Taa;
+            } else {
+                std::cerr << "❌ Unknown option: " << arg << "\n";
+                printUsage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+        } else if (arg == "--msaa=0" || arg == "--msaa=2" || arg == "--msaa=4" || arg == "--msaa=8") {
+            msaaSamples = arg.back() - '0';
+            if (!antiAliasingGiven) {
+                antiAliasing = AntiAliasing::Msaa;
+            }
+        } else if (arg.starts_with("--sim-rate=")) {
+            simulationRate = parseNumber(arg, "--sim-rate=", 1.0, 1000.0);
+        } else if (arg == "--frames-in-flight=0" || arg == "--frames-in-flight=1" || arg == "--frames-in-flight=2") {
+            framesInFlight = arg.back() - '0';
+        } else if (arg == "--report-latency") {
+            reportLatency = true;
+        } else if (arg.starts_with("--assets=")) {
+            assetPackPath = argv[i] + std::string_view("--assets=").size();
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            exit(EXIT_SUCCESS);
+        } else {
+            std::cerr << "❌ Unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // The post-process modes work on a single-sampled image; --msaa=0 is the same as --aa=off.
+    if (antiAliasing != AntiAliasing::Msaa) {
+        msaaSamples = 0;
+    } else if (msaaSamples < 2) {
+        antiAliasing = AntiAliasing::Off;
+    }
+}
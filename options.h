@@ -0,0 +1,62 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+enum class BaseCompression {
+    Off,    // Upload the composed base as RGBA8
+    Auto,   // BC1, or BC7 when the base has alpha; falls back to what the driver supports
+    BC1,
+    BC7
+};
+
+enum class MarbleMaterial {
+    Texture,    // marble.jpg from the asset pack, in an atlas page, with cylindrical UVs
+    Procedural, // Band-limited solid noise evaluated from object-space position
+    Streamed    // The full-resolution marble, only the tiles in view, through a feedback pass and a page table
+};
+
+enum class MipmapGeneration {
+    Compute,    // Single-pass compute shader with sRGB and alpha-aware filtering; falls back to Driver
+    Driver      // glGenerateMipmap
+};
+
+enum class VertexFormat {
+    Float,      // 36 bytes: float position, UV, layer and normal
+    Quantized   // 16 bytes: 16-bit position (scaled to the mesh bounds) and UV, 2_10_10_10 normal, 16-bit layer
+};
+
+enum class UpscaleFilter {
+    Bilinear,
+    Sharpen     // Bilinear plus an unsharp mask clamped to the neighbourhood
+};
+
+enum class AntiAliasing {
+    Off,
+    Msaa,       // Multisampled target with --msaa samples, resolved before the upscale
+    Fxaa,       // Edge-directed blur in the upscale pass
+    Taa         // Jittered projection, history reprojected by depth and clamped to the neighbourhood
+};
+
+inline BaseCompression baseCompression = BaseCompression::Auto;
+inline MarbleMaterial marbleMaterial = MarbleMaterial::Texture;
+inline int marbleDecodeScale = 0;      // 1, 2, 4 or 8 to force a JPEG DCT scale; 0 picks it from the screen size
+inline bool benchmarkMarble = false;           // Time procedural marble against the texture fetch, then exit
+inline const char* assetPackPath = nullptr;    // Memory-map this pack instead of the embedded one
+inline MipmapGeneration mipmapGeneration = MipmapGeneration::Compute;
+inline bool shaderCache = true;                // Keep linked program binaries on disk between runs
+inline bool benchmarkMipmaps = false;          // Time compute mip generation against glGenerateMipmap, then exit
+inline VertexFormat vertexFormat = VertexFormat::Float;
+inline bool vsync = true;
+inline double targetFps = 0.0;                 // Frame cap while focused; 0 leaves it to vsync (or uncapped)
+inline double unfocusedFps = 10.0;             // Frame cap while another window has focus
+inline float renderScale = 0.0f;               // Fixed scale of the window's resolution to draw at; 0 adapts it to the budget
+inline double frameBudgetMs = 0.0;             // GPU time for the scene with a dynamic scale; 0 derives it from the frame rate
+inline UpscaleFilter upscaleFilter = UpscaleFilter::Bilinear;
+inline AntiAliasing antiAliasing = AntiAliasing::Off;   // Cheapest with the offscreen target; --msaa=N alone selects Msaa
+inline int msaaSamples = 4;                    // Per pixel of the render target; the base rim uses alpha-to-coverage when > 1; 0 unless Msaa
+inline double simulationRate = 120.0;          // Fixed ticks per second of the animation thread
+inline int framesInFlight = 0;                 // Frames queued ahead of the GPU before the next waits; 0 leaves it to the driver
+inline bool reportLatency = false;             // Measure input-to-GPU latency without a frames-in-flight bound too
+
+void parseOptions(int argc, char** argv);
+
+#endif //OPTIONS_H
@@ -0,0 +1,210 @@
+#include "programCache.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+
+static constexpr uint32_t binaryMagic = 0x47525050;    // "PPRG"
+
+struct PendingProgram {
+    std::string key;
+    bool fromSource;
+};
+
+static bool cacheEnabled = false;
+static bool parallelCompile = false;
+static std::string driverIdentity;
+static std::filesystem::path cacheDirectory;
+static std::unordered_map<GLuint, PendingProgram> pendingPrograms;
+static ProgramCacheStats stats;
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static std::string programKey(const ShaderStages& stages) {
+    uint64_t hash = fnv1a(0xcbf29ce484222325ull, driverIdentity.data(), driverIdentity.size());
+    for (const auto& [type, source] : stages) {
+        hash = fnv1a(hash, &type, sizeof(type));
+        hash = fnv1a(hash, source.data(), source.size());
+    }
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+static std::filesystem::path defaultCacheDirectory() {
+    const char* home = getenv("HOME");
+#if defined(__APPLE__)
+    return home ? std::filesystem::path(home) / "Library/Caches/pawn/shaders" : std::filesystem::path();
+#else
+    if (const char* xdg = getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return std::filesystem::path(xdg) / "pawn/shaders";
+    }
+    return home ? std::filesystem::path(home) / ".cache/pawn/shaders" : std::filesystem::path();
+#endif
+}
+
+static const char* glString(GLenum name) {
+    const auto* value = reinterpret_cast<const char*>(glGetString(name));
+    return value ? value : "";
+}
+
+void initProgramCache(bool enabled) {
+    // The binary is only valid for the exact driver that produced it.
+    driverIdentity = std::string(glString(GL_VENDOR)) + "\n" + glString(GL_RENDERER) + "\n" + glString(GL_VERSION);
+
+    GLint binaryFormats = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    }
+    cacheDirectory = defaultCacheDirectory();
+    std::error_code error;
+    cacheEnabled = enabled && binaryFormats > 0 && !cacheDirectory.empty() && (std::filesystem::create_directories(cacheDirectory, error), !error);
+
+    // Let the driver compile on as many threads as it likes; links then finish in the background.
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        parallelCompile = true;
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        parallelCompile = true;
+    }
+}
+
+static bool loadBinary(GLuint program, const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t header[2];
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != binaryMagic) {
+        return false;
+    }
+    const std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // A driver update may still reject it; then it is simply rebuilt.
+    glProgramBinary(program, header[1], binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    return linked == GL_TRUE;
+}
+
+static void storeBinary(GLuint program, const std::filesystem::path& path) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+    // Write beside and rename, so a concurrent launch never reads half a file.
+    const std::filesystem::path temporary = path.string() + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        const uint32_t header[2] = { binaryMagic, format };
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file) {
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+}
+
+GLuint beginProgram(const ShaderStages& stages) {
+    const std::string key = programKey(stages);
+    GLuint program = glCreateProgram();
+
+    if (cacheEnabled) {
+        const std::filesystem::path path = cacheDirectory / (key + ".bin");
+        if (loadBinary(program, path)) {
+            pendingPrograms[program] = { key, false };
+            ++stats.loaded;
+            return program;
+        }
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        glDeleteProgram(program);
+        program = glCreateProgram();
+    }
+
+    // No status queries here: with parallel compilation they would wait for the driver's threads.
+    for (const auto& [type, source] : stages) {
+        GLuint shader = glCreateShader(type);
+        const char* text = source.c_str();
+        glShaderSource(shader, 1, &text, nullptr);
+        glCompileShader(shader);
+        glAttachShader(program, shader);
+        glDeleteShader(shader);     // Freed once detached in finishProgram()
+    }
+    if (cacheEnabled) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program);
+
+    pendingPrograms[program] = { key, true };
+    ++stats.compiled;
+    return program;
+}
+
+bool programReady(GLuint program) {
+    if (!parallelCompile) {
+        return true;
+    }
+    GLint done = GL_TRUE;
+    glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
+
+bool finishProgram(GLuint program) {
+    auto pending = pendingPrograms.find(program);
+    if (pending == pendingPrograms.end()) {
+        return true;
+    }
+    const PendingProgram build = pending->second;
+    pendingPrograms.erase(pending);
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    GLuint shaders[4];
+    GLsizei shaderCount = 0;
+    glGetAttachedShaders(program, 4, &shaderCount, shaders);
+
+    if (!linked) {
+        for (GLsizei i = 0; i < shaderCount; ++i) {
+            GLint compiled;
+            glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &compiled);
+            if (!compiled) {
+                char infoLog[512];
+                glGetShaderInfoLog(shaders[i], 512, nullptr, infoLog);
+                std::cerr << "❌ Shader compilation failed:\n" << infoLog << "\n";
+            }
+        }
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, nullptr, infoLog);
+        std::cerr << "❌ Shader linking failed:\n" << infoLog << "\n";
+    } else if (build.fromSource && cacheEnabled) {
+        storeBinary(program, cacheDirectory / (build.key + ".bin"));
+    }
+
+    for (GLsizei i = 0; i < shaderCount; ++i) {
+        glDetachShader(program, shaders[i]);
+    }
+    return linked == GL_TRUE;
+}
+
+ProgramCacheStats programCacheStats() {
+    return stats;
+}
@@ -0,0 +1,39 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+#include <GL/glew.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using ShaderStages = std::vector<std::pair<GLenum, std::string>>;    // Stage type, complete GLSL source
+
+// Call once after glewInit(): identifies the driver, picks the cache directory and enables parallel compilation.
+void initProgramCache(bool enabled = true);
+
+GLuint beginProgram(
+    /*
+     * Start building a program from `stages`. When a binary linked earlier by the same driver
+     * (GL_RENDERER, GL_VERSION) from the same sources is on disk, it is loaded with glProgramBinary;
+     * otherwise the stages are compiled and linked, which happens on the driver's threads when
+     * GL_KHR_parallel_shader_compile is available. Nothing here waits for the result.
+     */
+
+    const ShaderStages& stages
+);
+
+// Whether the program has finished linking; never blocks with GL_KHR_parallel_shader_compile, always true without it.
+bool programReady(GLuint program);
+
+// Wait for the link, report compile and link errors, and store the binary of freshly linked programs.
+// Uniform values and block bindings are not part of a binary, so set them after this.
+bool finishProgram(GLuint program);
+
+// Programs loaded from and compiled for the cache so far.
+struct ProgramCacheStats {
+    int loaded = 0;
+    int compiled = 0;
+};
+ProgramCacheStats programCacheStats();
+
+#endif //PROGRAMCACHE_H
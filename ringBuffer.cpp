@@ -0,0 +1,78 @@
+#include "ringBuffer.h"
+#include "glState.h"
+
+#include <iostream>
+
+
+RingBuffer::RingBuffer(size_t bytesPerFrame, int frames)
+    : regionSize(bytesPerFrame), frames(frames), fences(frames, nullptr) {
+    const auto size = static_cast<GLsizeiptr>(regionSize * frames);
+
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        name = glState.createBuffer(size, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glState.mapBufferRange(name, 0, size, flags));
+    } else {
+        name = glState.createBuffer(size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+    if (!mapped) {
+        staging.resize(regionSize);
+    }
+}
+
+RingBuffer::~RingBuffer() {
+    for (GLsync fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+    if (mapped) {
+        glState.unmapBuffer(name);
+    }
+    glDeleteBuffers(1, &name);
+}
+
+void RingBuffer::beginFrame() {
+    region = (region + 1) % frames;
+    used = 0;
+    flushed = 0;
+
+    GLsync& fence = fences[region];
+    if (!fence) {
+        return;
+    }
+    if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+        ++stallCount;
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100'000'000) == GL_TIMEOUT_EXPIRED) {
+        }
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+RingBuffer::Allocation RingBuffer::allocate(size_t bytes, size_t alignment) {
+    size_t offset = (used + alignment - 1) & ~(alignment - 1);
+    if (offset + bytes > regionSize) {
+        // Sized for the frame's worst case; running out is a bug, so overwrite rather than corrupt another frame.
+        std::cerr << "❌ Ring buffer region of " << regionSize << " bytes is full\n";
+        offset = 0;
+        flushed = 0;
+    }
+    used = offset + bytes;
+
+    unsigned char* base = mapped ? mapped + region * regionSize : staging.data();
+    return { base + offset, static_cast<GLintptr>(region * regionSize + offset) };
+}
+
+void RingBuffer::flush() {
+    if (!mapped && used > flushed) {
+        glState.bufferSubData(name, static_cast<GLintptr>(region * regionSize + flushed), static_cast<GLsizeiptr>(used - flushed),
+                              staging.data() + flushed);
+    }
+    flushed = used;
+}
+
+void RingBuffer::endFrame() {
+    flush();
+    fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,58 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+class RingBuffer {
+    /*
+     * One buffer split into `frames` regions, one per frame in flight, for data written every
+     * frame: the CPU fills region N while the GPU may still read N-1 and N-2. A fence at the end
+     * of each frame guards its region; beginFrame() waits on it before the region is reused,
+     * which only blocks when the CPU runs `frames` frames ahead.
+     *
+     * With GL_ARB_buffer_storage (GL 4.4) the buffer is mapped once, persistent and coherent, and
+     * allocations are written in place. Without it (macOS) allocations are staged in memory and
+     * flush() copies them with glBufferSubData() into the region, which the fence has already
+     * freed, so the driver neither copies aside nor waits.
+     */
+
+    public:
+        explicit RingBuffer(size_t bytesPerFrame, int frames = 3);
+        ~RingBuffer();
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        struct Allocation {
+            void* data;         // Write here before the frame's draws are submitted
+            GLintptr offset;    // Into buffer(), for glBindBufferRange() and the like
+        };
+
+        void beginFrame();
+        // Aligned to `alignment` (a power of two), from the current frame's region.
+        Allocation allocate(size_t bytes, size_t alignment);
+        // Make what was written since the last flush visible to draws submitted after this; free when persistent.
+        void flush();
+        // After the last draw that reads this frame's data.
+        void endFrame();
+
+        [[nodiscard]] GLuint buffer() const { return name; }
+        [[nodiscard]] bool persistent() const { return mapped != nullptr; }
+        // Frames for which beginFrame() had to wait for the GPU.
+        [[nodiscard]] long stalls() const { return stallCount; }
+
+    private:
+        size_t regionSize;
+        int frames;
+        GLuint name = 0;
+        unsigned char* mapped = nullptr;
+        std::vector<unsigned char> staging;
+        std::vector<GLsync> fences;
+        int region = 0;
+        size_t used = 0;
+        size_t flushed = 0;
+        long stallCount = 0;
+};
+
+#endif //RINGBUFFER_H
@@ -0,0 +1,189 @@
+#include "scratchArena.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+
+// Every allocation is preceded by its size, so realloc() knows how much to move.
+static constexpr size_t allocationHeader = 16;
+
+static size_t alignUp(size_t value) {
+    return (value + 15) & ~static_cast<size_t>(15);
+}
+
+static thread_local ScratchArena* threadArena = nullptr;
+
+// Frees may come from a thread without an open Scope, so ownership is checked against every live arena.
+static std::mutex liveArenasMutex;
+static std::vector<ScratchArena*> liveArenas;
+
+static ScratchArena* owningArena(const void* ptr) {
+    std::lock_guard lock(liveArenasMutex);
+    auto it = std::ranges::find_if(liveArenas, [ptr](const ScratchArena* arena) { return arena->owns(ptr); });
+    return it != liveArenas.end() ? *it : nullptr;
+}
+
+ScratchArena::ScratchArena(size_t blockSize) : blockSize(blockSize) {
+    std::lock_guard lock(liveArenasMutex);
+    liveArenas.push_back(this);
+}
+
+ScratchArena::~ScratchArena() {
+    reset();
+    std::lock_guard lock(liveArenasMutex);
+    std::erase(liveArenas, this);
+}
+
+void* ScratchArena::bump(size_t blockIndex, size_t size) {
+    Block& block = blocks[blockIndex];
+    unsigned char* header = block.data + block.used;
+    memcpy(header, &size, sizeof(size));
+    block.used += allocationHeader + alignUp(size);
+    lastAllocation = header + allocationHeader;
+    lastAllocationBlock = blockIndex;
+    return lastAllocation;
+}
+
+void* ScratchArena::allocate(size_t size) {
+    void* ptr = tryAllocate(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* ScratchArena::tryAllocate(size_t size) {
+    const size_t needed = allocationHeader + alignUp(size);
+    std::lock_guard lock(mutex);
+
+    if (current < blocks.size() && blocks[current].size - blocks[current].used >= needed) {
+        return bump(current, size);
+    }
+
+    // Big requests get a block of their own and leave the current small-allocation block alone.
+    const bool dedicated = needed > blockSize / 2;
+    const size_t bytes = dedicated ? needed : blockSize;
+    auto* data = static_cast<unsigned char*>(malloc(bytes));
+    if (!data) {
+        return nullptr;
+    }
+    blocks.push_back({ data, bytes, 0 });
+    if (!dedicated) {
+        current = blocks.size() - 1;
+    }
+    return bump(blocks.size() - 1, size);
+}
+
+void* ScratchArena::reallocate(void* ptr, size_t newSize) {
+    if (!ptr) {
+        return tryAllocate(newSize);
+    }
+
+    size_t oldSize;
+    memcpy(&oldSize, static_cast<unsigned char*>(ptr) - allocationHeader, sizeof(oldSize));
+    {
+        // The newest allocation of the current block grows in place; decoders grow their output buffers this way.
+        // One in a dedicated block does not: its header is only ever compared against its own block.
+        std::lock_guard lock(mutex);
+        if (ptr == lastAllocation && lastAllocationBlock == current && current < blocks.size()) {
+            Block& block = blocks[current];
+            unsigned char* header = static_cast<unsigned char*>(ptr) - allocationHeader;
+            const size_t start = static_cast<size_t>(header - block.data);
+            if (start + allocationHeader + alignUp(newSize) <= block.size) {
+                memcpy(header, &newSize, sizeof(newSize));
+                block.used = start + allocationHeader + alignUp(newSize);
+                return ptr;
+            }
+        }
+    }
+
+    // Like realloc(), a failed move leaves `ptr` as it was.
+    void* moved = tryAllocate(newSize);
+    if (moved) {
+        memcpy(moved, ptr, std::min(oldSize, newSize));
+    }
+    return moved;
+}
+
+bool ScratchArena::owns(const void* ptr) const {
+    std::lock_guard lock(mutex);
+    return std::ranges::any_of(blocks, [ptr](const Block& block) {
+        return ptr >= block.data && ptr < block.data + block.size;
+    });
+}
+
+void ScratchArena::reset() {
+    std::lock_guard lock(mutex);
+    for (Block& block : blocks) {
+        free(block.data);
+    }
+    blocks.clear();
+    current = 0;
+    lastAllocation = nullptr;
+}
+
+size_t ScratchArena::reservedBytes() const {
+    std::lock_guard lock(mutex);
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+size_t ScratchArena::usedBytes() const {
+    std::lock_guard lock(mutex);
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.used;
+    }
+    return total;
+}
+
+size_t ScratchArena::blockCount() const {
+    std::lock_guard lock(mutex);
+    return blocks.size();
+}
+
+ScratchArena::Scope::Scope(ScratchArena* arena) : previous(threadArena) {
+    threadArena = arena;
+}
+
+ScratchArena::Scope::~Scope() {
+    threadArena = previous;
+}
+
+ScratchArena* currentScratchArena() {
+    return threadArena;
+}
+
+void* scratchMalloc(size_t size) {
+    return threadArena ? threadArena->tryAllocate(size) : malloc(size);
+}
+
+void* scratchRealloc(void* ptr, size_t newSize) {
+    if (ScratchArena* arena = ptr ? owningArena(ptr) : threadArena) {
+        return arena->reallocate(ptr, newSize);
+    }
+    return realloc(ptr, newSize);
+}
+
+void scratchFree(void* ptr) {
+    if (ptr && !owningArena(ptr)) {
+        free(ptr);
+    }
+}
+
+size_t peakResidentSetBytes() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);            // Bytes on macOS
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;     // KiB on Linux
+#endif
+}
@@ -0,0 +1,108 @@
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+class ScratchArena {
+    /*
+     * Bump allocator for the short-lived startup buffers: decoder output and scratch, the SVG
+     * parse and raster, composition and compression staging. Frees are no-ops; everything is
+     * released in one go (reset() or the destructor) once the textures are on the GPU.
+     *
+     * Threads opt in with a Scope. While one is open, scratchMalloc() & co. (and through them the
+     * stb_image and NanoSVG allocation hooks) allocate from the arena. Allocation is thread-safe.
+     */
+
+    public:
+        explicit ScratchArena(size_t blockSize = 8 << 20);
+        ~ScratchArena();
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        // Throws std::bad_alloc, for ScratchAllocator.
+        void* allocate(size_t size);
+        // nullptr when out of memory, like malloc() and realloc(); the hooks for C code use these.
+        void* tryAllocate(size_t size);
+        void* reallocate(void* ptr, size_t newSize);
+        [[nodiscard]] bool owns(const void* ptr) const;
+        void reset();
+
+        [[nodiscard]] size_t reservedBytes() const;     // Blocks taken from the heap so far, i.e. the peak
+        [[nodiscard]] size_t usedBytes() const;
+        [[nodiscard]] size_t blockCount() const;
+
+        class Scope {
+            public:
+                explicit Scope(ScratchArena* arena);
+                ~Scope();
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                ScratchArena* previous;
+        };
+
+    private:
+        struct Block {
+            unsigned char* data;
+            size_t size;
+            size_t used;
+        };
+
+        mutable std::mutex mutex;
+        std::vector<Block> blocks;
+        size_t blockSize;
+        size_t current = 0;                     // Block that small allocations bump through
+        unsigned char* lastAllocation = nullptr;   // Can grow in place while it is in blocks[current]
+        size_t lastAllocationBlock = 0;
+
+        void* bump(size_t blockIndex, size_t size);
+};
+
+// Allocate from the calling thread's arena (see ScratchArena::Scope), or from the heap when none is open.
+void* scratchMalloc(size_t size);
+void* scratchRealloc(void* ptr, size_t newSize);
+void scratchFree(void* ptr);
+
+template <typename T>
+struct ScratchAllocator {
+    /*
+     * std::allocator stand-in that binds to the arena open when it is created, so a container
+     * may outlive the Scope on its thread as long as the arena itself is still alive.
+     */
+
+    using value_type = T;
+
+    ScratchArena* arena;
+
+    ScratchAllocator();
+    template <typename U>
+    ScratchAllocator(const ScratchAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena ? arena->allocate(count * sizeof(T)) : ::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) {
+        if (!arena) {
+            ::operator delete(ptr);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const ScratchAllocator<U>& other) const { return arena == other.arena; }
+};
+
+ScratchArena* currentScratchArena();
+
+template <typename T>
+ScratchAllocator<T>::ScratchAllocator() : arena(currentScratchArena()) {}
+
+template <typename T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+// Peak resident set size of the process so far, in bytes.
+size_t peakResidentSetBytes();
+
+#endif //SCRATCHARENA_H
@@ -4,8 +4,23 @@
 
 #include "setupGLFW.h"
 #include "shaders.h"
+#include "options.h"
+#include "glState.h"
 
 
+static void keyCallback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/) {
+    // Handled as events, so nothing is polled per frame and no press is missed between frames.
+    if (action != GLFW_PRESS) {
+        return;
+    }
+    if (key == GLFW_KEY_F) {
+        GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+        toggleFullscreen(window, monitor, glfwGetVideoMode(monitor), isFullscreen);
+    } else if (key == GLFW_KEY_ESCAPE) {
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+    }
+}
+
 GLFWwindow* initWindow(GLFWmonitor** outMonitor, const GLFWvidmode** outMode) {
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW.\n";
@@ -15,6 +30,8 @@ GLFWwindow* initWindow(GLFWmonitor** outMonitor, const GLFWvidmode** outMode) {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // Only a scene drawn straight into the window needs its multisamples; otherwise the render target has them.
+    glfwWindowHint(GLFW_SAMPLES, renderScale == 1.0f ? msaaSamples : 0);
 
     // Get monitor and video mode for fullscreen switching later
     *outMonitor = glfwGetPrimaryMonitor();
@@ -28,7 +45,8 @@ GLFWwindow* initWindow(GLFWmonitor** outMonitor, const GLFWvidmode** outMode) {
     }
 
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1); // Enable VSync
+    glfwSwapInterval(vsync ? 1 : 0);
+    glfwSetKeyCallback(window, keyCallback);
 
     glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) {
@@ -37,8 +55,9 @@ GLFWwindow* initWindow(GLFWmonitor** outMonitor, const GLFWvidmode** outMode) {
         glfwTerminate();
         exit(EXIT_FAILURE);
     }
+    glState.init();
 
-    glEnable(GL_DEPTH_TEST);
+    glState.setEnabled(GL_DEPTH_TEST, true);
     return window;
 }
 
@@ -60,42 +79,29 @@ void toggleFullscreen(GLFWwindow* window, GLFWmonitor* monitor, const GLFWvidmod
     isFullscreen = !isFullscreen;
 }
 
-float rotateAndSetLights(float position_x) {
-    double time = glfwGetTime();
+glm::mat4 rotateAndSetLights(const SceneState& scene, float aspect, glm::vec2 jitter) {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    double angle_x = 180.0 + 50.0 * sin(time * 0.3);
-    double angle_y = 60.0 + 60.0 * sin(time * 0.5);
-    double angle_z = 90.0 + 90.0 * cos(time * 0.25);
-
-    position_x = 1.3f * static_cast<float>(sin(time * 0.25f));
-
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position_x, 0.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(static_cast<float>(angle_x)), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(static_cast<float>(angle_y)), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(static_cast<float>(angle_z)), glm::vec3(0.0f, 0.0f, 1.0f));
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(scene.positionX, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(scene.angleX), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(scene.angleY), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(scene.angleZ), glm::vec3(0.0f, 0.0f, 1.0f));
 
-    float wiggle_y = 0.25f + 0.25f * static_cast<float>(sin((2.0f * M_PI / 7.0f) * time));
-    float wiggle_z = 2.5f + 0.5f * static_cast<float>(sin((2.0f * M_PI / 7.0f) * time));
+    glm::vec3 cameraPos(0.0f, scene.wiggleY, 2.5f);  // Matches the inverse of the view matrix
 
-    glm::vec3 cameraPos(0.0f, wiggle_y, 2.5f);  // Matches the inverse of the view matrix
-    glUniform3f(viewPosLoc, cameraPos.x, cameraPos.y, cameraPos.z);
+    glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, scene.wiggleY, -scene.wiggleZ));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 100.0f);
+    const glm::mat4 mvp = projection * view * model;
 
-    glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, wiggle_y, -wiggle_z));
-    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.f / 600.f, 0.1f, 100.0f);
-    glm::mat4 mvp = projection * view * model;
-
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, glm::value_ptr(mvp));
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-    glUniform3f(lightPos1Loc, -10.0f,  0.0f, 0.0f);
-    glUniform3f(lightPos2Loc,   0.0f, 10.0f, 0.0f);
-
-    float brightness = 2.0f; // 2x brighter
-    glUniform3f(lightColorLoc,
-        std::min(1.0f, brightness * 1.0f),
-        std::min(1.0f, brightness * 1.0f),
-        std::min(1.0f, brightness * 1.0f));
-
-    return position_x;
+    // One upload for everything that changes per frame; the lights are constant and live in the Material block.
+    FrameUniforms frame{};
+    frame.mvp = glm::translate(glm::mat4(1.0f), glm::vec3(jitter, 0.0f)) * mvp;     // Shifted in clip space by a sub-pixel offset
+    frame.model = model;
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+    for (int column = 0; column < 3; ++column) {
+        frame.normalMatrix[column] = glm::vec4(normalMatrix[column], 0.0f);
+    }
+    frame.viewPos = cameraPos;
+    updateFrameUniforms(frame);
+    return mvp;
 }
\ No newline at end of file
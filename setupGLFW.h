@@ -9,6 +9,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "simulation.h"
 
 #include <iostream>
 
@@ -18,5 +19,6 @@ inline int windowedWidth = 800, windowedHeight = 600;
 
 GLFWwindow* initWindow(GLFWmonitor** outMonitor, const GLFWvidmode** outMode);
 void toggleFullscreen(GLFWwindow* window, GLFWmonitor* monitor, const GLFWvidmode* mode, bool& isFullscreen);
-float rotateAndSetLights(float position_x);
+// Clear and upload the Frame block for `scene` as seen at `aspect`, offset by `jitter` in clip space; returns the unjittered MVP.
+glm::mat4 rotateAndSetLights(const SceneState& scene, float aspect, glm::vec2 jitter);
 #endif //SETUPGLFW_H
@@ -4,8 +4,21 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "shaders.h"
+#include "createTextureBase.h"
+#include "virtualTexture.h"
+#include "programCache.h"
+#include "glState.h"
 
 
 GLuint compileShader(GLenum type, const char* source) {
@@ -24,148 +37,396 @@ GLuint compileShader(GLenum type, const char* source) {
     return shader;
 }
 
-GLuint createShaderProgram() {
-    const char* vertexShaderSource = R"(
-        #version 330 core
+const char* const frameUniformsGLSL = R"(
+        layout(std140) uniform Frame {
+            mat4 uMVP;
+            mat4 uModel;
+            mat3 uNormalMatrix;     // Inverse transpose of uModel, computed once per frame on the CPU
+            vec3 viewPos;           // Camera position
+        };
+    )";
+
+const char* const materialUniformsGLSL = R"(
+        layout(std140) uniform Material {
+            vec4 pointLights[4];        // xyz; the first POINT_LIGHTS are used
+            vec4 positionScale;         // Quantized positions: object = aPos * scale + offset
+            vec4 positionOffset;
+            vec3 fillLightDir;          // Constant direction fill light
+            vec3 lightColor;
+            float baseRadius;           // Disc radius in object space, around the base's center
+            float baseEdgeWidth;
+        };
+    )";
 
+// std140 mirrors of the blocks above.
+static_assert(offsetof(FrameUniforms, normalMatrix) == 128 && offsetof(FrameUniforms, viewPos) == 176);
+static_assert(offsetof(MaterialUniforms, fillLightDir) == 96 && offsetof(MaterialUniforms, lightColor) == 112 &&
+              offsetof(MaterialUniforms, baseRadius) == 124 && offsetof(MaterialUniforms, baseEdgeWidth) == 128);
+
+const char* const meshPositionGLSL = R"(
         layout(location = 0) in vec3 aPos;
+
+        vec3 meshPosition() {
+#ifdef QUANTIZED_VERTICES
+            return aPos * positionScale.xyz + positionOffset.xyz;
+#else
+            return aPos;
+#endif
+        }
+    )";
+
+const char* const proceduralMarbleGLSL = R"(
+        // Solid marble evaluated from object-space position: no texture, no seam, no pole stretch.
+        float marbleHash(vec3 p) {
+            p = fract(p * 0.1031);
+            p += dot(p, p.zyx + 31.32);
+            return fract((p.x + p.y) * p.z);
+        }
+
+        float marbleValueNoise(vec3 p) {
+            vec3 i = floor(p);
+            vec3 f = fract(p);
+            vec3 u = f * f * f * (f * (f * 6.0 - 15.0) + 10.0);
+
+            return mix(mix(mix(marbleHash(i + vec3(0, 0, 0)), marbleHash(i + vec3(1, 0, 0)), u.x),
+                           mix(marbleHash(i + vec3(0, 1, 0)), marbleHash(i + vec3(1, 1, 0)), u.x), u.y),
+                       mix(mix(marbleHash(i + vec3(0, 0, 1)), marbleHash(i + vec3(1, 0, 1)), u.x),
+                           mix(marbleHash(i + vec3(0, 1, 1)), marbleHash(i + vec3(1, 1, 1)), u.x), u.y), u.z);
+        }
+
+        // Band-limited turbulence: octaves finer than the pixel footprint fade out instead of aliasing.
+        float marbleTurbulence(vec3 p, float footprint) {
+            float sum = 0.0;
+            float amplitude = 0.5;
+            float frequency = 1.0;
+            for (int i = 0; i < 5; ++i) {
+                float fade = 1.0 - smoothstep(0.25, 0.5, footprint * frequency);
+                sum += amplitude * fade * abs(marbleValueNoise(p * frequency) * 2.0 - 1.0);
+                frequency *= 2.0;
+                amplitude *= 0.5;
+            }
+            return sum;
+        }
+
+        const float marbleScale = 6.0;
+
+        // Pixel footprint in noise space. Needs derivatives, so evaluate it in uniform control flow.
+        float marbleFootprint(vec3 objectPos) {
+            return length(fwidth(objectPos * marbleScale));
+        }
+
+        vec3 proceduralMarble(vec3 objectPos, float footprint) {
+            vec3 p = objectPos * marbleScale;
+
+            float turbulence = marbleTurbulence(p, footprint);
+            float veins = pow(0.5 + 0.5 * sin(p.y * 1.7 + p.x * 0.6 + turbulence * 7.0), 3.0);
+
+            // The veins themselves are band-limited too: fade toward their mean as they approach a pixel.
+            veins = mix(veins, 0.3125, smoothstep(0.1, 0.3, footprint * 1.7));
+
+            vec3 stone = vec3(0.91, 0.90, 0.87) - 0.08 * turbulence;
+            vec3 vein = vec3(0.36, 0.37, 0.41);
+            return mix(stone, vein, veins);
+        }
+    )";
+
+static const char* const vertexShaderBody = R"(
         layout(location = 1) in vec2 aTexCoord;
-        layout(location = 2) in float aTexID;
+        layout(location = 2) in float aLayer;
         layout(location = 3) in vec3 aNormal;
 
         out vec2 TexCoord;
-        out float TexID;
+        flat out float Layer;
         out vec3 WorldPos;
+        out vec3 ObjectPos;
         out vec3 Normal;
 
-        uniform mat4 uMVP;
-        uniform mat4 uModel;
-
         void main() {
-            gl_Position = uMVP * vec4(aPos, 1.0);
+            vec3 position = meshPosition();
+            gl_Position = uMVP * vec4(position, 1.0);
             TexCoord = aTexCoord;
-            TexID = aTexID;
-            WorldPos = vec3(uModel * vec4(aPos, 1.0));
+            Layer = aLayer;
+            WorldPos = vec3(uModel * vec4(position, 1.0));
+            ObjectPos = position;
 
-            // Transform normal using the inverse transpose of the model matrix
-            Normal = mat3(transpose(inverse(uModel))) * aNormal;
+            Normal = uNormalMatrix * aNormal;
         }
     )";
 
-    const char* fragmentShaderSource = R"(
-        #version 330 core
+// Every feature is a #define, so each variant only contains the math its configuration needs.
+static const char* const fragmentShaderBody = R"(
         in vec2 TexCoord;
-        in float TexID;
+        flat in float Layer;
         in vec3 WorldPos;
+        in vec3 ObjectPos;
         in vec3 Normal;
 
         out vec4 FragColor;
 
-        uniform sampler2D texture1; // marble
-        uniform sampler2D texture2; // base
+        uniform sampler2DArray materials;  // One layer per material, selected per vertex
 
-        uniform vec3 lightPos1;
-        uniform vec3 lightPos2;
-        uniform vec3 lightDir3;  // NEW: constant direction light
-        uniform vec3 lightColor;
-        uniform vec3 viewPos;  // Camera position
+        float diffuseLighting(vec3 norm) {
+            float diffuse = 0.0;
+#if POINT_LIGHTS > 0
+            for (int i = 0; i < POINT_LIGHTS; ++i) {
+                diffuse += max(dot(norm, normalize(pointLights[i].xyz - WorldPos)), 0.0);
+            }
+            diffuse /= float(POINT_LIGHTS);
+#endif
+#ifdef FILL_LIGHT
+            diffuse += max(dot(norm, normalize(-fillLightDir)), 0.0) * FILL_STRENGTH;
+#endif
+            return diffuse * BRIGHTNESS;
+        }
+
+#ifdef SPECULAR
+        vec3 specularLighting(vec3 norm) {
+            vec3 viewDir = normalize(viewPos - WorldPos);
+            float specular = 0.0;
+            for (int i = 0; i < POINT_LIGHTS; ++i) {
+                vec3 reflectDir = reflect(-normalize(pointLights[i].xyz - WorldPos), norm);
+                specular += pow(max(dot(viewDir, reflectDir), 0.0), SHININESS);
+            }
+            return SPECULAR_STRENGTH * lightColor * (specular / float(POINT_LIGHTS)) * BRIGHTNESS;
+        }
+#endif
 
         void main() {
-            vec4 baseColor;
+#if defined(PROCEDURAL_MARBLE)
+            vec4 baseColor = vec4(proceduralMarble(ObjectPos, marbleFootprint(ObjectPos)), 1.0);
+#elif defined(STREAMED_MARBLE)
+            vec4 baseColor = streamedMarble(TexCoord, streamedMarbleLod(TexCoord, 0.0));
+#else
+            vec4 baseColor = texture(materials, vec3(TexCoord, Layer));
+#endif
+
+#ifdef ALPHA_MASK
+            // Circular mask around the base's center; its UVs point into an atlas region
+            float dist = length(ObjectPos.xz);
+            float alpha = 1.0 - smoothstep(baseRadius - baseEdgeWidth, baseRadius + baseEdgeWidth, dist);
+            baseColor.a *= alpha;
+
+#ifndef ALPHA_TO_COVERAGE
+            if (alpha < 0.01)
+                discard;
+#endif
+#endif
 
-            if (TexID < 0.5) {
-                baseColor = texture(texture1, TexCoord);
-            } else {
-                // Circular mask around center (0.5, 0.5)
-                vec2 centeredUV = TexCoord - vec2(0.5);
-                float dist = length(centeredUV);
+            vec3 norm = normalize(Normal);
+            vec3 litColor = baseColor.rgb * lightColor * diffuseLighting(norm);
+#ifdef SPECULAR
+            litColor += specularLighting(norm);
+#endif
 
-                float radius = 0.298;
-                float edgeWidth = 0.001; // much sharper edge
+            FragColor = vec4(litColor, baseColor.a);
+        }
+    )";
 
-                float alpha = 1.0 - smoothstep(radius - edgeWidth, radius + edgeWidth, dist);
-                baseColor = texture(texture2, TexCoord) * vec4(1.0, 1.0, 1.0, alpha);
+// Lighting model constants, compiled into every variant.
+static constexpr float brightness = 2.2f;
+static constexpr float fillStrength = 0.3f;
+static constexpr float shininess = 128.0f;
+static constexpr float specularStrength = 0.3f;
 
-                if (alpha < 0.01)
-                    discard;
-            }
+// The scene: two point lights and a fill light, constant, so they live in the Material block.
+static constexpr int scenePointLights = 2;
+static constexpr float lightIntensity = 2.0f;   // Of the light color, clamped to white; `brightness` scales the lit result
 
-            // Normalize normal
-            vec3 norm = normalize(Normal);
+uint32_t ShaderFeatures::key() const {
+    return static_cast<uint32_t>(albedo) | (static_cast<uint32_t>(pointLights) << 2) | (fillLight ? 1u << 5 : 0u) |
+           (specular ? 1u << 6 : 0u) | (alphaMask ? 1u << 7 : 0u) | (quantizedVertices ? 1u << 8 : 0u) |
+           (alphaToCoverage ? 1u << 9 : 0u);
+}
 
-            // View direction
-            vec3 viewDir = normalize(viewPos - WorldPos);
+std::string ShaderFeatures::defines() const {
+    std::string defines = "#define POINT_LIGHTS " + std::to_string(pointLights) + "\n";
+    if (fillLight) {
+        defines += "#define FILL_LIGHT\n";
+    }
+    if (specular && pointLights > 0) {
+        defines += "#define SPECULAR\n";
+    }
+    if (alphaMask) {
+        defines += "#define ALPHA_MASK\n";
+    }
+    if (alphaMask && alphaToCoverage) {
+        defines += "#define ALPHA_TO_COVERAGE\n";
+    }
+    if (quantizedVertices) {
+        defines += "#define QUANTIZED_VERTICES\n";
+    }
+    if (albedo == Albedo::ProceduralMarble) {
+        defines += "#define PROCEDURAL_MARBLE\n";
+    } else if (albedo == Albedo::StreamedMarble) {
+        defines += "#define STREAMED_MARBLE\n";
+    }
+    return defines;
+}
 
-            // Light directions
-            vec3 lightDir1 = normalize(lightPos1 - WorldPos);
-            vec3 lightDir2 = normalize(lightPos2 - WorldPos);
-            vec3 lightDir3Norm = normalize(-lightDir3); // assuming it's a direction, not a position
+ShaderFeatures pawnShaderFeatures() {
+    ShaderFeatures features;
+    features.albedo = (marbleMaterial == MarbleMaterial::Procedural) ? Albedo::ProceduralMarble :
+                      (marbleMaterial == MarbleMaterial::Streamed) ? Albedo::StreamedMarble : Albedo::MaterialArray;
+    features.pointLights = scenePointLights;
+    features.specular = true;     // Polished marble
+    features.quantizedVertices = vertexFormat == VertexFormat::Quantized;
+    return features;
+}
 
-            float diff1 = max(dot(norm, lightDir1), 0.0);
-            float diff2 = max(dot(norm, lightDir2), 0.0);
-            float diff3 = max(dot(norm, lightDir3Norm), 0.0) * 0.3; // fill light, softer
+ShaderFeatures baseShaderFeatures(bool rim, bool alphaToCoverage) {
+    ShaderFeatures features;
+    features.pointLights = scenePointLights;
+    features.alphaMask = rim;
+    features.alphaToCoverage = rim && alphaToCoverage;
+    features.quantizedVertices = vertexFormat == VertexFormat::Quantized;
+    return features;
+}
 
-            float brightnessFactor = 2.2;
-            float diffuseLighting = ((diff1 + diff2) * 0.5 + diff3) * brightnessFactor;
+std::string shaderPrelude(const ShaderFeatures& features) {
+    std::ostringstream constants;
+    constants << std::showpoint
+              << "#define BRIGHTNESS " << brightness << "\n"
+              << "#define FILL_STRENGTH " << fillStrength << "\n"
+              << "#define SHININESS " << shininess << "\n"
+              << "#define SPECULAR_STRENGTH " << specularStrength << "\n";
+
+    std::string prelude = "#version 330 core\n";
+    prelude += features.defines();
+    prelude += constants.str();
+    prelude += frameUniformsGLSL;
+    prelude += materialUniformsGLSL;
+    return prelude;
+}
 
-            // Initialize specular
-            vec3 specular = vec3(0.0);
+static std::unordered_map<uint32_t, GLuint> shaderVariants;
 
-            if (TexID < 0.5) {
-                // Only apply specular to top surface (marble)
-                float shininess = 128.0;
-                float specularStrength = 0.3;
+static GLuint beginVariant(const ShaderFeatures& features) {
+    const std::string prelude = shaderPrelude(features);
 
-                vec3 reflectDir1 = reflect(-lightDir1, norm);
-                vec3 reflectDir2 = reflect(-lightDir2, norm);
+    std::string vertexShaderSource = prelude;
+    vertexShaderSource += meshPositionGLSL;
+    vertexShaderSource += vertexShaderBody;
 
-                float spec1 = pow(max(dot(viewDir, reflectDir1), 0.0), shininess);
-                float spec2 = pow(max(dot(viewDir, reflectDir2), 0.0), shininess);
+    std::string fragmentShaderSource = prelude;
+    if (features.albedo == Albedo::ProceduralMarble) {
+        fragmentShaderSource += proceduralMarbleGLSL;
+    } else if (features.albedo == Albedo::StreamedMarble) {
+        fragmentShaderSource += streamedMarbleGLSL;
+    }
+    fragmentShaderSource += fragmentShaderBody;
 
-                float specularLighting = ((spec1 + spec2) * 0.5) * brightnessFactor;
-                specular = specularStrength * lightColor * specularLighting;
-            }
+    return beginProgram({ { GL_VERTEX_SHADER, vertexShaderSource }, { GL_FRAGMENT_SHADER, fragmentShaderSource } });
+}
 
-            // Combine diffuse and specular
-            vec3 litColor = baseColor.rgb * lightColor * diffuseLighting + specular;
+static void finishVariant(GLuint program) {
+    finishProgram(program);
+    bindUniformBlocks(program);
 
-            FragColor = vec4(litColor, baseColor.a);
+    glState.useProgram(program);
+    glUniform1i(glGetUniformLocation(program, "materials"), 0);
+    glUniform1i(glGetUniformLocation(program, "marblePool"), 1);
+    glUniform1i(glGetUniformLocation(program, "marblePageTable"), 2);
+}
+
+void prepareShaderVariants(std::initializer_list<ShaderFeatures> variants) {
+    // Start every missing variant before waiting on any, so a driver with parallel compilation builds them side by side.
+    std::vector<GLuint> started;
+    for (const ShaderFeatures& features : variants) {
+        if (!shaderVariants.contains(features.key())) {
+            started.push_back(shaderVariants[features.key()] = beginVariant(features));
         }
-    )";
+    }
+    for (GLuint program : started) {
+        finishVariant(program);
+    }
+}
+
+GLuint shaderVariant(const ShaderFeatures& features) {
+    auto it = shaderVariants.find(features.key());
+    if (it == shaderVariants.end()) {
+        prepareShaderVariants({ features });
+        it = shaderVariants.find(features.key());
+    }
+    return it->second;
+}
+
+void bindUniformBlocks(GLuint program) {
+    const GLuint frame = glGetUniformBlockIndex(program, "Frame");
+    if (frame != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, frame, frameUniformBinding);
+    }
+    const GLuint material = glGetUniformBlockIndex(program, "Material");
+    if (material != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, material, materialUniformBinding);
+    }
+}
 
+// Room for the Frame block and per-instance data to come; one region per frame in flight.
+static constexpr size_t frameRingBytes = 64 << 10;
 
+static std::unique_ptr<RingBuffer> frameRing;
+static size_t uniformOffsetAlignment = 256;
 
-    GLuint vs = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-    GLint linked;
-    glGetProgramiv(program, GL_LINK_STATUS, &linked);
-    if (!linked) {
-        char infoLog[512];
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        std::cerr << "❌ Shader linking failed:\n" << infoLog << "\n";
+RingBuffer& frameDataRing() {
+    return *frameRing;
+}
+
+void releaseFrameDataRing() {
+    frameRing.reset();
+}
+
+void updateFrameUniforms(const FrameUniforms& uniforms) {
+    // A fresh slice of this frame's ring region: earlier frames' draws may still be reading theirs.
+    const RingBuffer::Allocation slice = frameRing->allocate(sizeof(FrameUniforms), uniformOffsetAlignment);
+    memcpy(slice.data, &uniforms, sizeof(FrameUniforms));
+    frameRing->flush();
+    glState.bindBufferRange(GL_UNIFORM_BUFFER, frameUniformBinding, frameRing->buffer(), slice.offset, sizeof(FrameUniforms));
+}
+
+static MaterialUniforms uploaded{};
+
+void updateMaterialUniforms(const MaterialUniforms& uniforms) {
+    static bool valid = false;
+    if (valid && memcmp(&uploaded, &uniforms, sizeof(MaterialUniforms)) == 0) {
+        return;
     }
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    return program;
+    uploaded = uniforms;
+    valid = true;
+
+    glState.bufferSubData(materialUniformBuffer, 0, sizeof(MaterialUniforms), &uniforms);
+}
+
+const MaterialUniforms& currentMaterialUniforms() {
+    return uploaded;
 }
 
 void setupShaders() {
-    GLuint shaderProgram = createShaderProgram();
-    glUseProgram(shaderProgram);
-    glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
-    glUniform1i(glGetUniformLocation(shaderProgram, "texture2"), 1);
-
-    mvpLoc = glGetUniformLocation(shaderProgram, "uMVP");
-    modelLoc = glGetUniformLocation(shaderProgram, "uModel");
-    lightPos1Loc = glGetUniformLocation(shaderProgram, "lightPos1");
-    lightPos2Loc = glGetUniformLocation(shaderProgram, "lightPos2");
-    lightDir3Loc = glGetUniformLocation(shaderProgram, "lightDir3");
-    lightColorLoc = glGetUniformLocation(shaderProgram, "lightColor");
-    viewPosLoc = glGetUniformLocation(shaderProgram, "viewPos");
-    lightDir3 = glm::normalize(glm::vec3(0.3f, 1.0f, 0.2f));  // Fill light from above-front-right
-    glUniform3fv(lightDir3Loc, 1, glm::value_ptr(lightDir3));
+    const auto start = std::chrono::steady_clock::now();
+    initProgramCache(shaderCache);
+
+    prepareShaderVariants({ pawnShaderFeatures(), baseShaderFeatures(false), baseShaderFeatures(true, msaaSamples > 1) });
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    uniformOffsetAlignment = std::max<size_t>(alignment, 16);
+    frameRing = std::make_unique<RingBuffer>(frameRingBytes);
+
+    materialUniformBuffer = glState.createBuffer(sizeof(MaterialUniforms), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glState.bindBufferBase(GL_UNIFORM_BUFFER, materialUniformBinding, materialUniformBuffer);
+
+    // The lights don't move, so this block is uploaded once.
+    MaterialUniforms material{};
+    material.pointLights[0] = glm::vec4(-10.0f, 0.0f, 0.0f, 1.0f);
+    material.pointLights[1] = glm::vec4(0.0f, 10.0f, 0.0f, 1.0f);
+    material.fillLightDir = glm::normalize(glm::vec3(0.3f, 1.0f, 0.2f));  // Fill light from above-front-right
+
+    material.lightColor = glm::min(glm::vec3(1.0f), lightIntensity * glm::vec3(1.0f));
+
+    material.baseRadius = baseDiscRadius;
+    material.baseEdgeWidth = baseDiscEdgeWidth;
+    updateMaterialUniforms(material);
+
+    const ProgramCacheStats cache = programCacheStats();
+    std::cout << "⏱️  Shaders ready: " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+              << " ms (" << cache.loaded << " from the program cache, " << cache.compiled << " compiled)\n";
 }
\ No newline at end of file
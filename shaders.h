@@ -9,18 +9,107 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+#include "options.h"
+#include "ringBuffer.h"
+
+struct FrameUniforms {
+    /*
+     * std140 layout of the per-frame `Frame` block: a mat3 takes three vec4 columns.
+     */
+
+    glm::mat4 mvp;
+    glm::mat4 model;
+    glm::vec4 normalMatrix[3];
+    glm::vec3 viewPos;
+    float padding;
+};
+
+struct MaterialUniforms {
+    /*
+     * std140 layout of the `Material` block: lighting, vertex dequantization and the base mask,
+     * constant unless changed. A float following a vec3 takes its fourth component, as baseRadius does.
+     */
+
+    glm::vec4 pointLights[4];           // xyz; as many are used as the variant's ShaderFeatures::pointLights
+    glm::vec4 positionScale{ 1.0f };    // Only read by QUANTIZED_VERTICES variants
+    glm::vec4 positionOffset{ 0.0f };
+    glm::vec3 fillLightDir;
+    float padding;
+    glm::vec3 lightColor;
+    float baseRadius;
+    float baseEdgeWidth;
+    float edgePadding[3];               // std140 rounds the block's size up to a multiple of 16
+};
+static_assert(sizeof(MaterialUniforms) % 16 == 0, "The buffer must cover the whole std140 block");
+
+constexpr GLuint frameUniformBinding = 0;
+constexpr GLuint materialUniformBinding = 1;
+
 GLuint compileShader(GLenum type, const char* source);
-GLuint createShaderProgram();
+
+enum class Albedo { MaterialArray, ProceduralMarble, StreamedMarble };
+
+struct ShaderFeatures {
+    /*
+     * One shader variant: every field becomes a #define, so a variant contains only the lighting,
+     * masking and vertex decoding it uses and the compiler can fold the rest away.
+     */
+
+    Albedo albedo = Albedo::MaterialArray;
+    int pointLights = 2;            // 0–4, read from Material.pointLights
+    bool fillLight = true;
+    bool specular = false;          // Per point light
+    bool alphaMask = false;         // Circular base mask; discards, so it costs early depth testing
+    bool alphaToCoverage = false;   // With alphaMask: leave the edge to GL_SAMPLE_ALPHA_TO_COVERAGE instead of discarding
+    bool quantizedVertices = false; // VertexFormat::Quantized attributes
+
+    [[nodiscard]] uint32_t key() const;
+    [[nodiscard]] std::string defines() const;
+};
+
+// The pawn is opaque marble with specular and never discards, so early depth testing stays on for it.
+ShaderFeatures pawnShaderFeatures();
+// The base: the interior is opaque as well; only the `rim` variant applies the circular mask, and discards
+// unless drawn with alpha-to-coverage into a multisampled target.
+ShaderFeatures baseShaderFeatures(bool rim, bool alphaToCoverage = false);
+
+// "#version", the feature #defines, the lighting constants and both uniform blocks: the start of every stage of a variant.
+std::string shaderPrelude(const ShaderFeatures& features);
+
+// Build the variants not built yet, all started before any is waited on.
+void prepareShaderVariants(std::initializer_list<ShaderFeatures> variants);
+// The linked program for `features`, built on first use; bound to the uniform blocks, samplers set.
+GLuint shaderVariant(const ShaderFeatures& features);
+
 void setupShaders();
 
-inline GLuint shaderProgram;
-inline GLint mvpLoc;
-inline GLint modelLoc;
-inline GLint lightPos1Loc;
-inline GLint lightPos2Loc;
-inline GLint lightDir3Loc;
-inline GLint lightColorLoc;
-inline GLint viewPosLoc;
-inline glm::vec3 lightDir3;
+// Point a program's Frame and Material blocks (where it has them) at their binding points.
+void bindUniformBlocks(GLuint program);
+
+// Once per frame, before drawing: written into frameDataRing() and bound to the Frame block.
+void updateFrameUniforms(const FrameUniforms& uniforms);
+// Uploads only when `uniforms` differs from what the buffer already holds.
+void updateMaterialUniforms(const MaterialUniforms& uniforms);
+// What the Material buffer holds, to change a field and upload again.
+const MaterialUniforms& currentMaterialUniforms();
+
+// Per-frame (and later per-instance) data; beginFrame() before the first update of a frame, endFrame() after its last draw.
+RingBuffer& frameDataRing();
+// Deletes the ring while the GL context is current; static destruction would come after glfwTerminate().
+void releaseFrameDataRing();
+inline GLuint materialUniformBuffer;
+
+// GLSL declaring the Frame and Material uniform blocks.
+extern const char* const frameUniformsGLSL;
+extern const char* const materialUniformsGLSL;
+// GLSL declaring attribute 0 and `vec3 meshPosition()`, which dequantizes it under QUANTIZED_VERTICES; needs the Material block.
+extern const char* const meshPositionGLSL;
+
+// GLSL defining `vec3 proceduralMarble(vec3 objectPos, float footprint)` and `marbleFootprint`, shared with the marble benchmark.
+extern const char* const proceduralMarbleGLSL;
 
 #endif //SHADERS_H
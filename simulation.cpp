@@ -0,0 +1,148 @@
+#include "simulation.h"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+
+// The pawn's tumble and the camera's bob, as functions of time.
+static SceneState animate(double time) {
+    SceneState state;
+    state.time = time;
+    state.positionX = 1.3f * static_cast<float>(sin(time * 0.25));
+    state.angleX = static_cast<float>(180.0 + 50.0 * sin(time * 0.3));
+    state.angleY = static_cast<float>(60.0 + 60.0 * sin(time * 0.5));
+    state.angleZ = static_cast<float>(90.0 + 90.0 * cos(time * 0.25));
+    state.wiggleY = 0.25f + 0.25f * static_cast<float>(sin((2.0 * M_PI / 7.0) * time));
+    state.wiggleZ = 2.5f + 0.5f * static_cast<float>(sin((2.0 * M_PI / 7.0) * time));
+    return state;
+}
+
+static float mix(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+Simulation::Simulation(double tickRate, double unfocusedRate)
+    : tickSeconds(1.0 / tickRate), unfocusedTickSeconds(unfocusedRate > 0.0 ? std::max(tickSeconds, 1.0 / unfocusedRate) : tickSeconds) {
+}
+
+Simulation::~Simulation() {
+    stop();
+}
+
+void Simulation::start() {
+    // Published before the thread exists, so the first frame has something to draw.
+    const double now = glfwGetTime();
+    Snapshot& first = snapshots.back();
+    first.previous = animate(now - tickSeconds);
+    first.current = animate(now);
+    snapshots.publish();
+
+    running = true;
+    thread = std::thread(&Simulation::run, this, now);
+    std::cout << "🧩 Simulation: " << 1.0 / tickSeconds << " Hz fixed tick on its own thread\n";
+}
+
+void Simulation::stop() {
+    if (thread.joinable()) {
+        {
+            std::lock_guard lock(mutex);
+            running = false;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+}
+
+void Simulation::setPacing(PacingMode mode) {
+    {
+        std::lock_guard lock(mutex);
+        if (mode == pacingMode) {
+            return;
+        }
+        pacingMode = mode;
+    }
+    wake.notify_one();
+}
+
+double Simulation::tickInterval(PacingMode mode) const {
+    return (mode == PacingMode::Unfocused) ? unfocusedTickSeconds : tickSeconds;
+}
+
+void Simulation::run(double firstTick) {
+    SceneState last = animate(firstTick);
+    double nextTick = firstTick + tickSeconds;
+
+    std::unique_lock lock(mutex);
+    while (running) {
+        if (pacingMode == PacingMode::Hidden) {
+            wake.wait(lock, [this] { return !running || pacingMode != PacingMode::Hidden; });
+            // Resume from now: the hidden time is not a backlog, and the next snapshot must not span it.
+            nextTick = glfwGetTime();
+            last = animate(nextTick - tickInterval(pacingMode));
+            continue;
+        }
+
+        const double now = glfwGetTime();
+        if (now < nextTick) {
+            const PacingMode mode = pacingMode;
+            if (wake.wait_for(lock, std::chrono::duration<double>(nextTick - now), [&] { return !running || pacingMode != mode; })) {
+                // Regaining focus shouldn't wait out the rest of a slow unfocused tick.
+                nextTick = std::min(nextTick, last.time + tickInterval(pacingMode));
+            }
+            continue;
+        }
+        const double interval = tickInterval(pacingMode);
+        lock.unlock();
+
+        // Descheduled for more than a tick: skip to the present rather than replay the backlog.
+        if (const double behind = std::floor((now - nextTick) / interval); behind > 0.0) {
+            skippedTicks += static_cast<long>(behind);
+            nextTick += behind * interval;
+        }
+
+        const SceneState state = animate(nextTick);
+        snapshots.back() = { last, state };
+        snapshots.publish();
+        last = state;
+        ++ticks;
+        nextTick += interval;
+        lock.lock();
+    }
+}
+
+SceneState Simulation::sample(double time) {
+    snapshots.acquire();
+    const Snapshot& snapshot = snapshots.front();
+
+    // One tick behind, the newest two ticks bracket the time drawn, unless the simulation is late.
+    const double span = snapshot.current.time - snapshot.previous.time;
+    const double at = time - span;
+    double t = (span > 0.0) ? (at - snapshot.previous.time) / span : 1.0;
+    ++samples;
+    if (t > 1.0) {
+        ++starvedSamples;
+    }
+    t = std::clamp(t, 0.0, 1.0);
+
+    const SceneState& a = snapshot.previous;
+    const SceneState& b = snapshot.current;
+    const auto f = static_cast<float>(t);
+    SceneState state;
+    state.time = a.time + span * t;
+    state.positionX = mix(a.positionX, b.positionX, f);
+    state.angleX = mix(a.angleX, b.angleX, f);
+    state.angleY = mix(a.angleY, b.angleY, f);
+    state.angleZ = mix(a.angleZ, b.angleZ, f);
+    state.wiggleY = mix(a.wiggleY, b.wiggleY, f);
+    state.wiggleZ = mix(a.wiggleZ, b.wiggleZ, f);
+    return state;
+}
+
+void Simulation::report() const {
+    std::cout << "   → Simulation: " << ticks << " ticks, " << skippedTicks << " skipped; "
+              << starvedSamples << " of " << samples << " frames drawn past the newest tick\n";
+}
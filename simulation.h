@@ -0,0 +1,71 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "framePacer.h"
+#include "tripleBuffer.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct SceneState {
+    double time = 0.0;          // glfwGetTime() this state is for
+    float positionX = 0.0f;     // Pawn translation along x
+    float angleX = 0.0f, angleY = 0.0f, angleZ = 0.0f;     // Pawn rotation, degrees
+    float wiggleY = 0.0f, wiggleZ = 0.0f;                   // Camera offset
+};
+
+class Simulation {
+    /*
+     * Advances the scene on its own thread at a fixed tick, independent of the frame rate, so
+     * updates overlap with GL submission and the wait in glfwSwapBuffers(), and a stalled swap
+     * doesn't stall the animation. Each tick publishes the last two states through a triple
+     * buffer; the render thread samples one tick in the past and interpolates between them, so
+     * motion stays smooth at any ratio of frame rate to tick rate.
+     *
+     * The tick follows the frame pacer's mode: it drops to the unfocused frame rate while another
+     * window has focus, and the thread blocks on a condition variable while the window is hidden.
+     *
+     * Events and GL stay on the main thread, as GLFW requires.
+     */
+
+    public:
+        Simulation(double tickRate, double unfocusedRate);      // 0 keeps the full rate while unfocused
+        ~Simulation();
+        Simulation(const Simulation&) = delete;
+        Simulation& operator=(const Simulation&) = delete;
+
+        void start();
+        void stop();
+
+        // Main thread, every iteration before the pacer's wait: the window's mode (see pacingModeFor()).
+        void setPacing(PacingMode mode);
+
+        // Render thread: the scene as of `time`, delayed by one tick.
+        SceneState sample(double time);
+
+        // Ticks run and missed, and how often drawing got ahead of the newest tick.
+        void report() const;
+
+    private:
+        struct Snapshot {
+            SceneState previous, current;
+        };
+
+        double tickSeconds, unfocusedTickSeconds;
+        TripleBuffer<Snapshot> snapshots;
+        std::thread thread;
+
+        std::mutex mutex;                   // Guards the two below
+        std::condition_variable wake;       // Mode changes and stop()
+        bool running = false;
+        PacingMode pacingMode = PacingMode::Active;
+
+        long ticks = 0, skippedTicks = 0;   // Simulation thread; read after stop()
+        long samples = 0, starvedSamples = 0;
+
+        [[nodiscard]] double tickInterval(PacingMode mode) const;
+        void run(double firstTick);
+};
+
+#endif //SIMULATION_H
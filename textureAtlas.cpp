@@ -0,0 +1,182 @@
+#include "textureAtlas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+
+static int alignUp(int value, int alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+AtlasPacker::AtlasPacker(int pageWidth, int pageHeight, int gutter)
+    : width(pageWidth), height(pageHeight), gutter(std::max(1, gutter)) {}
+
+bool AtlasPacker::fit(const std::vector<SkylineNode>& skyline, int rectWidth, int rectHeight, int& bestIndex, int& bestX, int& bestY) const {
+    // Bottom-left: the lowest resting position, ties broken by the narrowest skyline segment.
+    int bestWidth = INT_MAX;
+    bestIndex = -1;
+    bestY = INT_MAX;
+
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        const int x = skyline[i].x;
+        if (x + rectWidth > width) {
+            break;
+        }
+
+        // The rectangle rests on the highest segment it spans.
+        int y = 0;
+        int remaining = rectWidth;
+        for (size_t j = i; remaining > 0 && j < skyline.size(); ++j) {
+            y = std::max(y, skyline[j].y);
+            remaining -= skyline[j].width;
+        }
+        if (y + rectHeight > height) {
+            continue;
+        }
+
+        if (y < bestY || (y == bestY && skyline[i].width < bestWidth)) {
+            bestIndex = static_cast<int>(i);
+            bestX = x;
+            bestY = y;
+            bestWidth = skyline[i].width;
+        }
+    }
+    return bestIndex >= 0;
+}
+
+void AtlasPacker::place(std::vector<SkylineNode>& skyline, int index, int x, int y, int rectWidth, int rectHeight) {
+    skyline.insert(skyline.begin() + index, { x, y + rectHeight, rectWidth });
+
+    // Trim or drop the segments now covered by the new one.
+    for (size_t i = index + 1; i < skyline.size();) {
+        const int covered = skyline[i - 1].x + skyline[i - 1].width - skyline[i].x;
+        if (covered <= 0) {
+            break;
+        }
+        if (covered >= skyline[i].width) {
+            skyline.erase(skyline.begin() + static_cast<long>(i));
+            continue;
+        }
+        skyline[i].x += covered;
+        skyline[i].width -= covered;
+        break;
+    }
+
+    // Merge neighbours at the same height.
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + static_cast<long>(i) + 1);
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool AtlasPacker::pack(int imageWidth, int imageHeight, AtlasRegion& region) {
+    const int rectWidth = alignUp(imageWidth + 2 * gutter, gutter);
+    const int rectHeight = alignUp(imageHeight + 2 * gutter, gutter);
+    if (rectWidth > width || rectHeight > height) {
+        return false;
+    }
+
+    int index = -1, x = 0, y = 0;
+    size_t page = 0;
+    while (page < pages.size() && !fit(pages[page], rectWidth, rectHeight, index, x, y)) {
+        ++page;
+    }
+    if (page == pages.size()) {
+        pages.push_back({ { 0, 0, width } });
+        fit(pages[page], rectWidth, rectHeight, index, x, y);
+    }
+    place(pages[page], index, x, y, rectWidth, rectHeight);
+    usedWidth = std::max(usedWidth, x + rectWidth);
+    usedHeight = std::max(usedHeight, y + rectHeight);
+
+    region.page = static_cast<int>(page);
+    region.x = x + gutter;
+    region.y = y + gutter;
+    region.width = imageWidth;
+    region.height = imageHeight;
+    mapAtlasRegion(region, width, height);
+    return true;
+}
+
+void mapAtlasRegion(AtlasRegion& region, int pageWidth, int pageHeight) {
+    region.uvScale[0] = static_cast<float>(region.width) / static_cast<float>(pageWidth);
+    region.uvScale[1] = static_cast<float>(region.height) / static_cast<float>(pageHeight);
+    region.uvOffset[0] = static_cast<float>(region.x) / static_cast<float>(pageWidth);
+    region.uvOffset[1] = static_cast<float>(region.y) / static_cast<float>(pageHeight);
+}
+
+bool packAtlasTight(const std::vector<std::array<int, 2>>& sizes, int maxPageSize, int gutter, std::vector<AtlasRegion>& regions,
+                    int& pageWidth, int& pageHeight, int& pageCount) {
+    gutter = std::max(1, gutter);
+    std::vector<size_t> order(sizes.size());
+    int widest = gutter, totalWidth = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        order[i] = i;
+        const int rectWidth = alignUp(sizes[i][0] + 2 * gutter, gutter);
+        widest = std::max(widest, rectWidth);
+        totalWidth += rectWidth;
+    }
+    std::ranges::stable_sort(order, [&](size_t a, size_t b) { return sizes[a][1] > sizes[b][1]; });
+
+    // A few dozen candidate widths are plenty for a handful of images.
+    const int widthLimit = std::min(maxPageSize, std::max(widest, totalWidth));
+    const int step = alignUp(std::max(gutter, (widthLimit - widest) / 32), gutter);
+
+    long long bestArea = LLONG_MAX;
+    for (int candidate = widest; candidate <= widthLimit; candidate += step) {
+        AtlasPacker packer(candidate, maxPageSize, gutter);
+        std::vector<AtlasRegion> packed(sizes.size());
+        bool fits = true;
+        for (size_t i : order) {
+            fits = fits && packer.pack(sizes[i][0], sizes[i][1], packed[i]);
+        }
+        if (!fits) {
+            return false;
+        }
+
+        const long long area = static_cast<long long>(packer.packedWidth()) * packer.packedHeight() * packer.pageCount();
+        if (area < bestArea) {
+            bestArea = area;
+            regions = std::move(packed);
+            pageWidth = packer.packedWidth();
+            pageHeight = packer.packedHeight();
+            pageCount = packer.pageCount();
+        }
+    }
+    if (bestArea == LLONG_MAX) {
+        return false;
+    }
+
+    for (AtlasRegion& region : regions) {
+        mapAtlasRegion(region, pageWidth, pageHeight);
+    }
+    return true;
+}
+
+void blitIntoAtlas(unsigned char* page, int pageWidth, const AtlasRegion& region, int gutter, const unsigned char* rgba, bool wrap) {
+    auto source = [wrap](int i, int size) {
+        return wrap ? ((i % size) + size) % size : std::clamp(i, 0, size - 1);
+    };
+
+    const size_t rowTexels = static_cast<size_t>(region.width) + 2 * gutter;
+    std::vector<unsigned char> row(rowTexels * 4);
+
+    for (int y = -gutter; y < region.height + gutter; ++y) {
+        const unsigned char* src = rgba + static_cast<size_t>(source(y, region.height)) * region.width * 4;
+
+        // The image row itself, then its gutter texels either side.
+        memcpy(row.data() + static_cast<size_t>(gutter) * 4, src, static_cast<size_t>(region.width) * 4);
+        for (int x = 0; x < gutter; ++x) {
+            memcpy(row.data() + static_cast<size_t>(x) * 4, src + static_cast<size_t>(source(x - gutter, region.width)) * 4, 4);
+            memcpy(row.data() + (static_cast<size_t>(gutter) + region.width + x) * 4, src + static_cast<size_t>(source(region.width + x, region.width)) * 4, 4);
+        }
+
+        unsigned char* dst = page + (static_cast<size_t>(region.y + y) * pageWidth + region.x - gutter) * 4;
+        memcpy(dst, row.data(), row.size());
+    }
+}
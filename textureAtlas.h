@@ -0,0 +1,90 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+#include <array>
+#include <vector>
+
+struct AtlasRegion {
+    /*
+     * Where a packed image landed. `x`, `y`, `width` and `height` cover the image itself,
+     * its gutter lies around it. Map the image's own UVs with uv * uvScale + uvOffset.
+     */
+
+    int page = 0;
+    int x = 0, y = 0, width = 0, height = 0;
+    float uvScale[2] = { 1.0f, 1.0f };
+    float uvOffset[2] = { 0.0f, 0.0f };
+};
+
+class AtlasPacker {
+    /*
+     * Skyline bottom-left packer over fixed-size pages; a new page opens when nothing fits.
+     * Every image gets `gutter` texels of its own edge (clamped or wrapped) on each side, and
+     * rectangles start on multiples of `gutter`, so the first log2(gutter) mip levels never
+     * blend neighbours and block-compressed pages (gutter >= 4) never share a block.
+     */
+
+    public:
+        AtlasPacker(int pageWidth, int pageHeight, int gutter = 8);
+
+        // False if the image plus its gutter cannot fit on an empty page.
+        bool pack(int width, int height, AtlasRegion& region);
+
+        [[nodiscard]] int pageCount() const { return static_cast<int>(pages.size()); }
+        [[nodiscard]] int pageWidth() const { return width; }
+        [[nodiscard]] int pageHeight() const { return height; }
+        [[nodiscard]] int gutterSize() const { return gutter; }
+        // Right and bottom edge of everything packed so far, over all pages, gutters included.
+        [[nodiscard]] int packedWidth() const { return usedWidth; }
+        [[nodiscard]] int packedHeight() const { return usedHeight; }
+
+    private:
+        struct SkylineNode {
+            int x, y, width;
+        };
+
+        int width, height, gutter;
+        int usedWidth = 0, usedHeight = 0;
+        std::vector<std::vector<SkylineNode>> pages;
+
+        bool fit(const std::vector<SkylineNode>& skyline, int rectWidth, int rectHeight, int& bestIndex, int& bestX, int& bestY) const;
+        static void place(std::vector<SkylineNode>& skyline, int index, int x, int y, int rectWidth, int rectHeight);
+};
+
+// Point the region's UV transform at pages of this size.
+void mapAtlasRegion(AtlasRegion& region, int pageWidth, int pageHeight);
+
+bool packAtlasTight(
+    /*
+     * Pack images of `sizes` (width, height) onto pages no larger than `maxPageSize` square, as
+     * tightly as the skyline allows: tallest first, trying page widths from the widest image up,
+     * and keeping the layout with the least total page area. Every page is then trimmed to the
+     * largest packed extent, since pages share one size as texture array layers; earlier pages
+     * fill before a new one opens, so the spare room collects on the last. `regions` follows `sizes`, mapped to that size.
+     * False if an image plus its gutter cannot fit a page at all.
+     */
+
+    const std::vector<std::array<int, 2>>& sizes,
+    int maxPageSize,
+    int gutter,
+    std::vector<AtlasRegion>& regions,
+    int& pageWidth,
+    int& pageHeight,
+    int& pageCount
+);
+
+void blitIntoAtlas(
+    /*
+     * Copy an RGBA8 image into its region of an RGBA8 page and fill the gutter around it:
+     * wrapped for images that tile (so filtering across their seam stays continuous), edge-clamped otherwise.
+     * Only the region and its gutter are written, one row at a time, so `page` may be a mapped pixel buffer.
+     */
+
+    unsigned char* page,
+    int pageWidth,
+    const AtlasRegion& region,
+    int gutter,
+    const unsigned char* rgba,
+    bool wrap
+);
+
+#endif //TEXTUREATLAS_H
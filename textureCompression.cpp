@@ -0,0 +1,511 @@
+#include "textureCompression.h"
+#include "scratchArena.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+// ---- Shared helpers ----
+static int blocksAcross(int pixels) {
+    return (pixels + 3) / 4;
+}
+
+static size_t blockBytes(BlockFormat format) {
+    return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+int mipLevelCount(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        ++levels;
+    }
+    return levels;
+}
+
+size_t compressedSize(BlockFormat format, int width, int height, int levels) {
+    size_t bytes = 0;
+    for (int level = 0; level < levels; ++level) {
+        bytes += static_cast<size_t>(blocksAcross(width)) * blocksAcross(height) * blockBytes(format);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return bytes;
+}
+
+BlockFormat chooseBlockFormat(const unsigned char* rgba, int width, int height) {
+    const size_t texels = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < texels; ++i) {
+        if (rgba[i * 4 + 3] != 255) {
+            return BlockFormat::BC7;
+        }
+    }
+    return BlockFormat::BC1;
+}
+
+static void fetchBlock(const unsigned char* rgba, int width, int height, int bx, int by, int block[16][4]) {
+    // Partial blocks at the right/bottom edge repeat the last row/column.
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            int sx = std::min(bx * 4 + x, width - 1);
+            int sy = std::min(by * 4 + y, height - 1);
+            const unsigned char* p = rgba + (static_cast<size_t>(sy) * width + sx) * 4;
+            for (int c = 0; c < 4; ++c) {
+                block[y * 4 + x][c] = p[c];
+            }
+        }
+    }
+}
+
+static void principalAxis(const int block[16][4], int channels, float mean[4], float axis[4]) {
+    /*
+     * Mean and dominant eigenvector of the block's color covariance (power iteration).
+     */
+
+    for (int c = 0; c < 4; ++c) {
+        mean[c] = 0.0f;
+        axis[c] = (c < channels) ? 1.0f : 0.0f;
+    }
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < channels; ++c) {
+            mean[c] += static_cast<float>(block[i][c]) / 16.0f;
+        }
+    }
+
+    float cov[4][4]{};
+    for (int i = 0; i < 16; ++i) {
+        float d[4]{};
+        for (int c = 0; c < channels; ++c) {
+            d[c] = static_cast<float>(block[i][c]) - mean[c];
+        }
+        for (int a = 0; a < channels; ++a) {
+            for (int b = 0; b < channels; ++b) {
+                cov[a][b] += d[a] * d[b];
+            }
+        }
+    }
+
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[4]{};
+        for (int a = 0; a < channels; ++a) {
+            for (int b = 0; b < channels; ++b) {
+                next[a] += cov[a][b] * axis[b];
+            }
+        }
+        float len = 0.0f;
+        for (int c = 0; c < channels; ++c) {
+            len += next[c] * next[c];
+        }
+        if (len < 1e-12f) {
+            return;  // Flat block: any axis will do
+        }
+        len = std::sqrt(len);
+        for (int c = 0; c < channels; ++c) {
+            axis[c] = next[c] / len;
+        }
+    }
+}
+
+static void endpointsAlongAxis(const int block[16][4], int channels, float e0[4], float e1[4]) {
+    float mean[4], axis[4];
+    principalAxis(block, channels, mean, axis);
+
+    float minT = FLT_MAX, maxT = -FLT_MAX;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < channels; ++c) {
+            t += (static_cast<float>(block[i][c]) - mean[c]) * axis[c];
+        }
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+
+    // Inset the endpoints slightly; the extremes are usually outliers of the interpolated palette.
+    float inset = (maxT - minT) / 16.0f;
+    minT += inset;
+    maxT -= inset;
+
+    for (int c = 0; c < 4; ++c) {
+        e0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+        e1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+    }
+}
+
+// ---- BC1 ----
+static uint16_t packRGB565(const float rgb[3]) {
+    auto r = static_cast<uint16_t>(std::lround(rgb[0] * 31.0f / 255.0f));
+    auto g = static_cast<uint16_t>(std::lround(rgb[1] * 63.0f / 255.0f));
+    auto b = static_cast<uint16_t>(std::lround(rgb[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void unpackRGB565(uint16_t color, int rgb[3]) {
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+static void bc1Palette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+    unpackRGB565(c0, palette[0]);
+    unpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (c0 > c1) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+}
+
+static int bc1Indices(const int block[16][4], uint16_t c0, uint16_t c1, uint32_t& indices) {
+    int palette[4][3];
+    bc1Palette(c0, c1, palette);
+
+    // Three-colour mode only arises for c0 == c1, where every texel maps to entry 0 anyway.
+    const int entries = (c0 > c1) ? 4 : 1;
+
+    int error = 0;
+    indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = 0, bestError = INT32_MAX;
+        for (int p = 0; p < entries; ++p) {
+            int e = 0;
+            for (int c = 0; c < 3; ++c) {
+                int d = block[i][c] - palette[p][c];
+                e += d * d;
+            }
+            if (e < bestError) {
+                bestError = e;
+                best = p;
+            }
+        }
+        indices |= static_cast<uint32_t>(best) << (2 * i);
+        error += bestError;
+    }
+    return error;
+}
+
+static void orderedEndpoints(const float e0[3], const float e1[3], uint16_t& c0, uint16_t& c1) {
+    c0 = packRGB565(e0);
+    c1 = packRGB565(e1);
+    if (c0 < c1) {
+        std::swap(c0, c1);
+    }
+}
+
+static void encodeBC1(const int block[16][4], unsigned char* out) {
+    float e0[4], e1[4];
+    endpointsAlongAxis(block, 3, e0, e1);
+
+    uint16_t c0, c1;
+    orderedEndpoints(e0, e1, c0, c1);
+    uint32_t indices;
+    int error = bc1Indices(block, c0, c1, indices);
+
+    if (c0 > c1) {
+        // One least-squares refit of the endpoints for the chosen indices.
+        static constexpr float weight0[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+        float aa = 0, bb = 0, ab = 0, ax[3]{}, bx[3]{};
+        for (int i = 0; i < 16; ++i) {
+            float a = weight0[(indices >> (2 * i)) & 3], b = 1.0f - a;
+            aa += a * a;
+            bb += b * b;
+            ab += a * b;
+            for (int c = 0; c < 3; ++c) {
+                ax[c] += a * static_cast<float>(block[i][c]);
+                bx[c] += b * static_cast<float>(block[i][c]);
+            }
+        }
+        float det = aa * bb - ab * ab;
+        if (std::fabs(det) > 1e-6f) {
+            float r0[3], r1[3];
+            for (int c = 0; c < 3; ++c) {
+                r0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.0f, 255.0f);
+                r1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.0f, 255.0f);
+            }
+            uint16_t r0c, r1c;
+            orderedEndpoints(r0, r1, r0c, r1c);
+            uint32_t refitIndices;
+            int refitError = bc1Indices(block, r0c, r1c, refitIndices);
+            if (refitError < error) {
+                c0 = r0c;
+                c1 = r1c;
+                indices = refitIndices;
+            }
+        }
+    }
+
+    out[0] = c0 & 0xff;
+    out[1] = c0 >> 8;
+    out[2] = c1 & 0xff;
+    out[3] = c1 >> 8;
+    for (int i = 0; i < 4; ++i) {
+        out[4 + i] = (indices >> (8 * i)) & 0xff;
+    }
+}
+
+static void decodeBC1(const unsigned char* in, int block[16][4]) {
+    auto c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    auto c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+    uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+
+    int palette[4][3];
+    bc1Palette(c0, c1, palette);
+    for (int i = 0; i < 16; ++i) {
+        int p = (indices >> (2 * i)) & 3;
+        for (int c = 0; c < 3; ++c) {
+            block[i][c] = palette[p][c];
+        }
+        block[i][3] = 255;
+    }
+}
+
+// ---- BC7 (mode 6: one subset, RGBA 7.7.7.7 + unique p-bit, 4-bit indices) ----
+static constexpr int bc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+static int bc7Interpolate(int e0, int e1, int index) {
+    return ((64 - bc7Weights4[index]) * e0 + bc7Weights4[index] * e1 + 32) >> 6;
+}
+
+static void bc7QuantizeEndpoint(const float value[4], int quantized[4], int& pBit) {
+    // Try both p-bits and keep the one that lands closer to the unquantized endpoint.
+    float bestError = FLT_MAX;
+    for (int p = 0; p < 2; ++p) {
+        int q[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            q[c] = std::clamp(static_cast<int>(std::lround((value[c] - static_cast<float>(p)) / 2.0f)), 0, 127);
+            float d = static_cast<float>((q[c] << 1) | p) - value[c];
+            error += d * d;
+        }
+        if (error < bestError) {
+            bestError = error;
+            pBit = p;
+            std::copy(q, q + 4, quantized);
+        }
+    }
+}
+
+struct BitWriter {
+    unsigned char* out;
+    int position = 0;
+
+    void put(uint32_t value, int bits) {
+        for (int i = 0; i < bits; ++i, ++position) {
+            if ((value >> i) & 1) {
+                out[position >> 3] |= static_cast<unsigned char>(1 << (position & 7));
+            }
+        }
+    }
+};
+
+struct BitReader {
+    const unsigned char* in;
+    int position = 0;
+
+    uint32_t get(int bits) {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i, ++position) {
+            value |= static_cast<uint32_t>((in[position >> 3] >> (position & 7)) & 1) << i;
+        }
+        return value;
+    }
+};
+
+static void encodeBC7(const int block[16][4], unsigned char* out) {
+    float e0[4], e1[4];
+    endpointsAlongAxis(block, 4, e0, e1);
+
+    int q0[4], q1[4], p0, p1;
+    bc7QuantizeEndpoint(e0, q0, p0);
+    bc7QuantizeEndpoint(e1, q1, p1);
+
+    int indices[16];
+    for (int i = 0; i < 16; ++i) {
+        int best = 0, bestError = INT32_MAX;
+        for (int index = 0; index < 16; ++index) {
+            int error = 0;
+            for (int c = 0; c < 4; ++c) {
+                int d = block[i][c] - bc7Interpolate((q0[c] << 1) | p0, (q1[c] << 1) | p1, index);
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = index;
+            }
+        }
+        indices[i] = best;
+    }
+
+    // The anchor (texel 0) index is stored without its top bit, so it must be < 8.
+    if (indices[0] & 8) {
+        std::swap(q0, q1);
+        std::swap(p0, p1);
+        for (int& index : indices) {
+            index = 15 - index;
+        }
+    }
+
+    std::memset(out, 0, 16);
+    BitWriter writer{out};
+    writer.put(1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        writer.put(q0[c], 7);
+        writer.put(q1[c], 7);
+    }
+    writer.put(p0, 1);
+    writer.put(p1, 1);
+    writer.put(indices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.put(indices[i], 4);
+    }
+}
+
+static void decodeBC7(const unsigned char* in, int block[16][4]) {
+    BitReader reader{in};
+    reader.get(7);
+    int q[2][4];
+    for (int c = 0; c < 4; ++c) {
+        q[0][c] = static_cast<int>(reader.get(7));
+        q[1][c] = static_cast<int>(reader.get(7));
+    }
+    int p0 = static_cast<int>(reader.get(1)), p1 = static_cast<int>(reader.get(1));
+    for (int i = 0; i < 16; ++i) {
+        int index = static_cast<int>(reader.get(i == 0 ? 3 : 4));
+        for (int c = 0; c < 4; ++c) {
+            block[i][c] = bc7Interpolate((q[0][c] << 1) | p0, (q[1][c] << 1) | p1, index);
+        }
+    }
+}
+
+// ---- Mip chain and threading ----
+static void downsample(const unsigned char* src, int width, int height, ScratchVector<unsigned char>& dst, int& outWidth, int& outHeight) {
+    outWidth = std::max(1, width / 2);
+    outHeight = std::max(1, height / 2);
+    dst.resize(static_cast<size_t>(outWidth) * outHeight * 4);
+
+    for (int y = 0; y < outHeight; ++y) {
+        int y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+        for (int x = 0; x < outWidth; ++x) {
+            int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+            for (int c = 0; c < 4; ++c) {
+                int sum = src[(static_cast<size_t>(y0) * width + x0) * 4 + c] + src[(static_cast<size_t>(y0) * width + x1) * 4 + c] +
+                          src[(static_cast<size_t>(y1) * width + x0) * 4 + c] + src[(static_cast<size_t>(y1) * width + x1) * 4 + c];
+                dst[(static_cast<size_t>(y) * outWidth + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+static double compressLevel(const unsigned char* rgba, int width, int height, BlockFormat format, unsigned char* dst, bool measure) {
+    /*
+     * Compress one level; returns the RGB sum of squared errors when `measure` is set.
+     */
+
+    const int blocksX = blocksAcross(width), blocksY = blocksAcross(height);
+    const size_t bytesPerBlock = blockBytes(format);
+    const int threadCount = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, blocksY);
+
+    std::vector<double> errors(threadCount, 0.0);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t] {
+            int block[16][4], decoded[16][4];
+            for (int by = t; by < blocksY; by += threadCount) {
+                for (int bx = 0; bx < blocksX; ++bx) {
+                    // Encode into a cached local block so `dst` is only ever written, never read back.
+                    unsigned char encoded[16];
+                    fetchBlock(rgba, width, height, bx, by, block);
+
+                    if (format == BlockFormat::BC1) {
+                        encodeBC1(block, encoded);
+                    } else {
+                        encodeBC7(block, encoded);
+                    }
+                    std::memcpy(dst + (static_cast<size_t>(by) * blocksX + bx) * bytesPerBlock, encoded, bytesPerBlock);
+
+                    if (!measure) {
+                        continue;
+                    }
+
+                    if (format == BlockFormat::BC1) {
+                        decodeBC1(encoded, decoded);
+                    } else {
+                        decodeBC7(encoded, decoded);
+                    }
+                    for (int y = 0; y < 4 && by * 4 + y < height; ++y) {
+                        for (int x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                            for (int c = 0; c < 3; ++c) {
+                                double d = block[y * 4 + x][c] - decoded[y * 4 + x][c];
+                                errors[t] += d * d;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double sum = 0.0;
+    for (double e : errors) {
+        sum += e;
+    }
+    return sum;
+}
+
+bool compressTexture(const unsigned char* rgba, int width, int height, BlockFormat format, unsigned char* dst, size_t capacity, CompressionStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+
+    const int levels = mipLevelCount(width, height);
+    if (capacity < compressedSize(format, width, height, levels)) {
+        std::cerr << "❌ Compression target too small\n";
+        return false;
+    }
+
+    stats = {};
+    ScratchVector<unsigned char> mip;
+    ScratchVector<unsigned char> nextMip;
+    const unsigned char* level = rgba;
+    int levelWidth = width, levelHeight = height;
+    size_t offset = 0;
+
+    for (int i = 0; i < levels; ++i) {
+        double error = compressLevel(level, levelWidth, levelHeight, format, dst + offset, i == 0);
+        if (i == 0) {
+            double mse = error / (static_cast<double>(width) * height * 3.0);
+            stats.psnr = (mse > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / mse) : INFINITY;
+        }
+
+        stats.uncompressedBytes += static_cast<size_t>(levelWidth) * levelHeight * 4;
+        offset += compressedSize(format, levelWidth, levelHeight, 1);
+
+        if (i + 1 < levels) {
+            int nextWidth, nextHeight;
+            downsample(level, levelWidth, levelHeight, nextMip, nextWidth, nextHeight);
+            mip.swap(nextMip);
+            level = mip.data();
+            levelWidth = nextWidth;
+            levelHeight = nextHeight;
+        }
+    }
+
+    stats.compressedBytes = offset;
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef TEXTURECOMPRESSION_H
+#define TEXTURECOMPRESSION_H
+#include <cstddef>
+
+enum class BlockFormat {
+    BC1,    // 4 bpp RGB, for mostly flat opaque content such as the carpet
+    BC7     // 8 bpp RGBA (mode 6 only), when alpha or quality demands it
+};
+
+struct CompressionStats {
+    double milliseconds = 0.0;
+    size_t uncompressedBytes = 0;   // RGBA8 including the full mip chain
+    size_t compressedBytes = 0;
+    double psnr = 0.0;              // Level 0, RGB, in dB
+};
+
+int mipLevelCount(int width, int height);
+
+// Bytes needed for `levels` mip levels of `format` blocks, level 0 first, levels tightly packed.
+size_t compressedSize(BlockFormat format, int width, int height, int levels);
+
+// Picks BC7 when any texel is not fully opaque, BC1 otherwise.
+BlockFormat chooseBlockFormat(const unsigned char* rgba, int width, int height);
+
+bool compressTexture(
+    /*
+     * Compress an RGBA8 image and its box-filtered mip chain into `dst`.
+     * Blocks are written in order and never read back, so `dst` may be a mapped pixel buffer.
+     * Work is split by block rows across the hardware threads.
+     */
+
+    const unsigned char* rgba,
+    int width,
+    int height,
+    BlockFormat format,
+    unsigned char* dst,
+    size_t capacity,
+    CompressionStats& stats
+);
+
+#endif //TEXTURECOMPRESSION_H
@@ -0,0 +1,106 @@
+// Build-time tool: packs files into assets.pack (see assetPackFormat.h).
+//
+// Usage: packAssets <output> <name>=<file> [<name>=<file> ...]
+//
+// With zstd available each entry is compressed, but only kept that way when it saves at least
+// a tenth; JPEG and PNG payloads are already entropy-coded and are stored as they are.
+
+#include "assetPackFormat.h"
+
+#ifdef PAWN_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+struct PackedAsset {
+    AssetPackEntry entry{};
+    std::vector<char> payload;
+};
+
+static bool readFile(const std::string& path, std::vector<char>& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output> <name>=<file> [<name>=<file> ...]\n";
+        return 1;
+    }
+
+    std::vector<PackedAsset> assets;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t separator = arg.find('=');
+        std::string name = arg.substr(0, separator);
+        if (separator == std::string::npos || name.empty() || name.size() >= sizeof(AssetPackEntry::name)) {
+            std::cerr << "❌ Expected <name>=<file> with a name under " << sizeof(AssetPackEntry::name) << " characters: " << arg << "\n";
+            return 1;
+        }
+
+        PackedAsset asset;
+        if (!readFile(arg.substr(separator + 1), asset.payload)) {
+            std::cerr << "❌ Cannot read " << arg.substr(separator + 1) << "\n";
+            return 1;
+        }
+        memcpy(asset.entry.name, name.c_str(), name.size() + 1);
+        asset.entry.codec = AssetCodec::Stored;
+        asset.entry.size = asset.payload.size();
+
+#ifdef PAWN_HAVE_ZSTD
+        std::vector<char> compressed(ZSTD_compressBound(asset.payload.size()));
+        size_t compressedSize = ZSTD_compress(compressed.data(), compressed.size(), asset.payload.data(), asset.payload.size(), 19);
+        if (!ZSTD_isError(compressedSize) && compressedSize < asset.payload.size() - asset.payload.size() / 10) {
+            compressed.resize(compressedSize);
+            asset.payload = std::move(compressed);
+            asset.entry.codec = AssetCodec::Zstd;
+        }
+#endif
+        asset.entry.packedSize = asset.payload.size();
+        assets.push_back(std::move(asset));
+    }
+
+    AssetPackHeader header{};
+    memcpy(header.magic, assetPackMagic, sizeof(header.magic));
+    header.version = assetPackVersion;
+    header.entryCount = static_cast<uint32_t>(assets.size());
+
+    uint64_t offset = sizeof(AssetPackHeader) + assets.size() * sizeof(AssetPackEntry);
+    for (PackedAsset& asset : assets) {
+        offset = (offset + 15) & ~uint64_t(15);
+        asset.entry.offset = offset;
+        offset += asset.entry.packedSize;
+    }
+
+    std::ofstream out(argv[1], std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const PackedAsset& asset : assets) {
+        out.write(reinterpret_cast<const char*>(&asset.entry), sizeof(asset.entry));
+    }
+    for (const PackedAsset& asset : assets) {
+        while (static_cast<uint64_t>(out.tellp()) < asset.entry.offset) {
+            out.put('\0');
+        }
+        out.write(asset.payload.data(), static_cast<std::streamsize>(asset.payload.size()));
+
+        std::cout << "   → " << asset.entry.name << ": " << asset.entry.size << " → " << asset.entry.packedSize << " bytes"
+                  << (asset.entry.codec == AssetCodec::Zstd ? " (zstd)" : " (stored)") << "\n";
+    }
+
+    if (!out) {
+        std::cerr << "❌ Writing " << argv[1] << " failed\n";
+        return 1;
+    }
+    return 0;
+}
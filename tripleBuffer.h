@@ -0,0 +1,49 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+    /*
+     * Hands the latest value from one writer thread to one reader thread without locks or waits.
+     * Of three slots the writer owns one, the reader owns one and the third is shared: publish()
+     * swaps the writer's slot with the shared one and marks it fresh, acquire() swaps the shared
+     * slot with the reader's if it is fresh. Neither side ever touches the other's slot, so a value
+     * is read whole; values the reader doesn't get to in time are simply overwritten.
+     */
+
+    public:
+        // Writer: fill this in, then publish() it.
+        T& back() { return slots[backIndex].value; }
+        void publish() {
+            backIndex = shared.exchange(static_cast<uint8_t>(backIndex | freshBit), std::memory_order_acq_rel) & indexMask;
+        }
+
+        // Reader: take the newest published value if there is one. True when front() changed.
+        bool acquire() {
+            if (!(shared.load(std::memory_order_relaxed) & freshBit)) {
+                return false;
+            }
+            frontIndex = shared.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+            return true;
+        }
+        [[nodiscard]] const T& front() const { return slots[frontIndex].value; }
+
+    private:
+        static constexpr uint8_t indexMask = 3;
+        static constexpr uint8_t freshBit = 4;
+
+        struct alignas(64) Slot {   // Own cache lines, so writing one slot never stalls reads of another
+            T value{};
+        };
+
+        std::array<Slot, 3> slots;
+        alignas(64) std::atomic<uint8_t> shared{ 1 };
+        uint8_t backIndex = 0;      // Writer only
+        uint8_t frontIndex = 2;     // Reader only
+};
+
+#endif //TRIPLEBUFFER_H
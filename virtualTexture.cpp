@@ -0,0 +1,541 @@
+#include "virtualTexture.h"
+#include "assetPack.h"
+#include "imageDecode.h"
+#include "shaders.h"
+#include "programCache.h"
+#include "glState.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <unordered_set>
+
+
+// Page table rows per level are passed as a uniform array of this size.
+static constexpr int maxLevels = 16;
+
+const char* const streamedMarbleGLSL = R"(
+        uniform sampler2D marblePool;        // Resident tiles with their borders
+        uniform sampler2D marblePageTable;   // Per tile: pool slot (rg), resident level (b), mapped (a)
+        uniform ivec2 marbleSize;            // Level 0 texels
+        uniform int marbleTileSize;
+        uniform int marbleTileBorder;
+        uniform int marblePoolTiles;         // Slots per side
+        uniform int marbleLevels;
+        uniform int marblePageRows[16];      // First page table row of each level
+
+        ivec2 marbleLevelSize(int level) {
+            return (marbleSize + (1 << level) - 1) >> level;
+        }
+
+        // Mip level from the texel footprint. Needs derivatives, so evaluate it in uniform control flow.
+        float streamedMarbleLod(vec2 uv, float bias) {
+            vec2 texel = uv * vec2(marbleSize);
+            float footprint = max(length(dFdx(texel)), length(dFdy(texel)));
+            return clamp(log2(max(footprint, 1e-6)) + bias, 0.0, float(marbleLevels - 1));
+        }
+
+        ivec2 streamedMarbleTile(vec2 wrapped, int level) {
+            return ivec2(wrapped * vec2(marbleLevelSize(level))) / marbleTileSize;
+        }
+
+        // Bilinear lookup at `level`, or at the nearest resident level above it.
+        vec4 streamedMarbleLevel(vec2 wrapped, int level) {
+            ivec2 tile = streamedMarbleTile(wrapped, level);
+            vec4 entry = texelFetch(marblePageTable, ivec2(tile.x, marblePageRows[level] + tile.y), 0);
+            if (entry.a < 0.5) {
+                return vec4(0.84, 0.82, 0.79, 1.0);     // Nothing resident yet
+            }
+
+            ivec3 mapping = ivec3(entry.rgb * 255.0 + 0.5);
+            vec2 texel = wrapped * vec2(marbleLevelSize(mapping.b));
+            vec2 inTile = texel - vec2(streamedMarbleTile(wrapped, mapping.b) * marbleTileSize);
+            float slotSize = float(marbleTileSize + 2 * marbleTileBorder);
+            vec2 pool = (vec2(mapping.rg) * slotSize + float(marbleTileBorder) + inTile) / (slotSize * float(marblePoolTiles));
+            return textureLod(marblePool, pool, 0.0);
+        }
+
+        vec4 streamedMarble(vec2 uv, float lod) {
+            vec2 wrapped = fract(uv);
+            int level = int(lod);
+            int coarser = min(level + 1, marbleLevels - 1);
+            return mix(streamedMarbleLevel(wrapped, level), streamedMarbleLevel(wrapped, coarser), fract(lod));
+        }
+    )";
+
+static GLuint createFeedbackProgram() {
+    const char* vertexShaderBody = R"(
+        layout(location = 1) in vec2 aTexCoord;
+
+        out vec2 TexCoord;
+
+        void main() {
+            gl_Position = uMVP * vec4(meshPosition(), 1.0);
+            TexCoord = aTexCoord;
+        }
+    )";
+
+    // The pawn's prelude, so the feedback pass decodes the same vertex format as the pawn it mirrors.
+    const std::string prelude = shaderPrelude(pawnShaderFeatures());
+
+    std::string vertexShaderSource = prelude;
+    vertexShaderSource += meshPositionGLSL;
+    vertexShaderSource += vertexShaderBody;
+
+    std::string fragmentShaderSource = prelude;
+    fragmentShaderSource += streamedMarbleGLSL;
+    fragmentShaderSource += R"(
+        in vec2 TexCoord;
+
+        out vec4 FragColor;
+
+        uniform float lodBias;  // The feedback target is smaller than the screen, so its derivatives are larger
+
+        void main() {
+            float lod = streamedMarbleLod(TexCoord, lodBias);
+            int level = int(lod);
+            ivec2 tile = streamedMarbleTile(fract(TexCoord), level);
+            FragColor = vec4(vec3(tile, level), 255.0) / 255.0;
+        }
+    )";
+
+    return beginProgram({ { GL_VERTEX_SHADER, vertexShaderSource }, { GL_FRAGMENT_SHADER, fragmentShaderSource } });
+}
+
+VirtualTexture::VirtualTexture(const std::string& assetName, int tileSize, int maxPoolTilesPerSide)
+    : assetName(assetName), tileSize(tileSize), poolTilesPerSide(maxPoolTilesPerSide) {
+    const Asset source = loadAsset(assetName.c_str());
+    int channels;
+    if (!source || !imageDecodeSize(source.data, source.size, 1, width, height, channels)) {
+        std::cerr << "❌ " << assetName << " missing from the asset pack, nothing to stream\n";
+        return;
+    }
+
+    // Down to the level that fits a single tile, which stays resident as the fallback for everything.
+    levels = 1;
+    while (levels < maxLevels && std::max(levelWidth(levels - 1), levelHeight(levels - 1)) > tileSize) {
+        ++levels;
+    }
+    levelCache.resize(levels);
+
+    // Feedback and page table entries carry tile coordinates in 8-bit channels.
+    if (tilesX(0) > 256 || tilesY(0) > 256) {
+        std::cerr << "❌ " << assetName << " (" << width << "x" << height << ") has more than 256 tiles of " << tileSize
+                  << "² per row or column, not streaming it\n";
+        levels = 0;
+        return;
+    }
+
+    pageTableWidth = tilesX(0);
+    for (int level = 0; level < levels; ++level) {
+        pageRowOffsets.push_back(pageTableHeight);
+        pageTableHeight += tilesY(level);
+    }
+    pageEntries.assign(static_cast<size_t>(pageTableWidth) * pageTableHeight * 4, 0);
+
+    // A source with fewer tiles than the pool has slots gets a pool that just holds them all, and the
+    // pool always stays below the plain texture with its mip chain, or streaming saves nothing.
+    const int slotSize = tileSize + 2 * border;
+    size_t plainBytes = 0;
+    for (int level = 0; level < levels; ++level) {
+        tileCount += tilesX(level) * tilesY(level);
+        plainBytes += static_cast<size_t>(levelWidth(level)) * levelHeight(level) * 4;
+    }
+    const auto poolFits = [&](int side) { return static_cast<size_t>(side) * side * slotSize * slotSize * 4 < plainBytes; };
+    poolTilesPerSide = 1;
+    while (poolTilesPerSide < maxPoolTilesPerSide && poolTilesPerSide * poolTilesPerSide < tileCount && poolFits(poolTilesPerSide + 1)) {
+        ++poolTilesPerSide;
+    }
+    if (poolTilesPerSide < 2 || !poolFits(poolTilesPerSide)) {
+        std::cerr << "❌ " << assetName << " (" << width << "x" << height << ") is too small for a tile pool to save memory, not streaming it\n";
+        levels = 0;
+        return;
+    }
+
+    pool = glState.createTexture(GL_TEXTURE_2D);
+    glState.textureStorage2D(pool, GL_TEXTURE_2D, 1, GL_RGBA8, slotSize * poolTilesPerSide, slotSize * poolTilesPerSide);
+    glState.textureParameter(pool, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glState.textureParameter(pool, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glState.textureParameter(pool, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glState.textureParameter(pool, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    pageTable = glState.createTexture(GL_TEXTURE_2D);
+    glState.textureStorage2D(pageTable, GL_TEXTURE_2D, 1, GL_RGBA8, pageTableWidth, pageTableHeight);
+    glState.textureSubImage2D(pageTable, GL_TEXTURE_2D, 0, 0, 0, pageTableWidth, pageTableHeight, GL_RGBA, GL_UNSIGNED_BYTE, pageEntries.data());
+    glState.textureParameter(pageTable, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glState.textureParameter(pageTable, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    slots.resize(static_cast<size_t>(poolTilesPerSide) * poolTilesPerSide);
+
+    // Built in the background; feedback starts once it has linked (see beginFeedback()).
+    feedbackProgram = createFeedbackProgram();
+
+    // The coarsest tile first; finer ones follow feedback.
+    wanted.push_back({ levels - 1, 0, 0 });
+
+    const size_t poolBytes = static_cast<size_t>(slotSize) * slotSize * slots.size() * 4;
+    std::cout << "🧩 Streaming " << assetName << ": " << width << "x" << height << ", " << levels << " levels of "
+              << tileSize << "² tiles\n";
+    std::cout << "   → Tile pool: " << slots.size() << " slots for " << tileCount << " tiles, " << poolBytes / 1024 << " KiB; page table "
+              << pageTableWidth << "x" << pageTableHeight << "\n";
+}
+
+VirtualTexture::~VirtualTexture() {
+    // Runs after the GL context is gone, like the texture streamer; only the worker needs waiting for.
+    if (job.valid()) {
+        job.wait();
+    }
+}
+
+int VirtualTexture::levelWidth(int level) const {
+    return (width + (1 << level) - 1) >> level;
+}
+
+int VirtualTexture::levelHeight(int level) const {
+    return (height + (1 << level) - 1) >> level;
+}
+
+int VirtualTexture::tilesX(int level) const {
+    return (levelWidth(level) + tileSize - 1) / tileSize;
+}
+
+int VirtualTexture::tilesY(int level) const {
+    return (levelHeight(level) + tileSize - 1) / tileSize;
+}
+
+uint64_t VirtualTexture::key(const VirtualTile& tile) const {
+    return (static_cast<uint64_t>(tile.level) << 40) | (static_cast<uint64_t>(tile.y) << 20) | static_cast<uint64_t>(tile.x);
+}
+
+void VirtualTexture::setUniforms(GLuint program) const {
+    glState.useProgram(program);
+
+    GLint rows[maxLevels] = {};
+    std::copy(pageRowOffsets.begin(), pageRowOffsets.end(), rows);
+    glUniform2i(glGetUniformLocation(program, "marbleSize"), width, height);
+    glUniform1i(glGetUniformLocation(program, "marbleTileSize"), tileSize);
+    glUniform1i(glGetUniformLocation(program, "marbleTileBorder"), border);
+    glUniform1i(glGetUniformLocation(program, "marblePoolTiles"), poolTilesPerSide);
+    glUniform1i(glGetUniformLocation(program, "marbleLevels"), levels);
+    glUniform1iv(glGetUniformLocation(program, "marblePageRows"), maxLevels, rows);
+}
+
+bool VirtualTexture::beginFeedback() {
+    if (!valid() || feedbackFence) {
+        return false;
+    }
+    if (!feedbackProgramLinked) {
+        if (!programReady(feedbackProgram)) {
+            return false;
+        }
+        feedbackProgramLinked = true;
+        finishProgram(feedbackProgram);
+        bindUniformBlocks(feedbackProgram);
+        setUniforms(feedbackProgram);
+        glUniform1f(glGetUniformLocation(feedbackProgram, "lodBias"), -std::log2(static_cast<float>(feedbackDivisor)));
+    }
+
+    previousViewport = glState.currentViewport();
+    previousProgram = glState.program();
+    previousFramebuffer = glState.framebuffer();
+    const int w = std::max(1, previousViewport[2] / feedbackDivisor);
+    const int h = std::max(1, previousViewport[3] / feedbackDivisor);
+    if (w != feedbackWidth || h != feedbackHeight) {
+        feedbackWidth = w;
+        feedbackHeight = h;
+        if (!feedbackFbo) {
+            glGenFramebuffers(1, &feedbackFbo);
+            glGenRenderbuffers(1, &feedbackDepth);
+            glGenBuffers(1, &feedbackPbo);
+        } else {
+            glState.deleteTexture(feedbackColor);   // Immutable storage: a new size needs a new texture
+        }
+        feedbackColor = glState.createTexture(GL_TEXTURE_2D);
+        glState.textureStorage2D(feedbackColor, GL_TEXTURE_2D, 1, GL_RGBA8, w, h);
+        glState.textureParameter(feedbackColor, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glBindRenderbuffer(GL_RENDERBUFFER, feedbackDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+        glState.bindFramebuffer(feedbackFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, feedbackColor, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, feedbackDepth);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, feedbackPbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(w) * h * 4, nullptr, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    glState.bindFramebuffer(feedbackFbo);
+    glState.viewport(0, 0, w, h);
+    constexpr GLfloat noRequest[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    constexpr GLfloat farDepth = 1.0f;
+    glClearBufferfv(GL_COLOR, 0, noRequest);
+    glClearBufferfv(GL_DEPTH, 0, &farDepth);
+
+    glState.useProgram(feedbackProgram);
+    return true;
+}
+
+void VirtualTexture::endFeedback() {
+    // Read back into the PBO without waiting; update() picks it up once the fence has passed.
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, feedbackPbo);
+    glReadPixels(0, 0, feedbackWidth, feedbackHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    feedbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    glState.bindFramebuffer(previousFramebuffer);
+    glState.viewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glState.useProgram(previousProgram);
+}
+
+void VirtualTexture::readFeedback() {
+    if (!feedbackFence) {
+        return;
+    }
+    const GLenum status = glClientWaitSync(feedbackFence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return;
+    }
+    glDeleteSync(feedbackFence);
+    feedbackFence = nullptr;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, feedbackPbo);
+    const auto* pixels = static_cast<const unsigned char*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+        static_cast<GLsizeiptr>(feedbackWidth) * feedbackHeight * 4, GL_MAP_READ_BIT));
+    if (!pixels) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return;
+    }
+
+    std::unordered_set<uint64_t> seen;
+    std::vector<VirtualTile> requested;
+    const size_t count = static_cast<size_t>(feedbackWidth) * feedbackHeight;
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* p = pixels + i * 4;
+        if (p[3] == 0 || p[2] >= levels) {
+            continue;
+        }
+
+        // A visible tile keeps its ancestors too; they are what it falls back to.
+        for (VirtualTile tile{ p[2], p[0], p[1] }; tile.level < levels; ++tile.level, tile.x /= 2, tile.y /= 2) {
+            if (!seen.insert(key(tile)).second) {
+                break;
+            }
+            requested.push_back(tile);
+        }
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    feedbackFrame = frame;
+    wanted.clear();
+    for (const VirtualTile& tile : requested) {
+        if (auto it = residentSlots.find(key(tile)); it != residentSlots.end()) {
+            slots[it->second].lastUsed = std::max(slots[it->second].lastUsed, frame);
+        } else {
+            wanted.push_back(tile);
+        }
+    }
+
+    // Coarse tiles first: they cover the most screen and are the fallback for the finer ones.
+    std::ranges::sort(wanted, [](const VirtualTile& a, const VirtualTile& b) { return a.level > b.level; });
+}
+
+const std::vector<unsigned char>& VirtualTexture::decodeLevel(int level) {
+    std::vector<unsigned char>& pixels = levelCache[level];
+    if (!pixels.empty()) {
+        return pixels;
+    }
+
+    const int w = levelWidth(level), h = levelHeight(level);
+    // JPEG DCT scaling gives levels 1-3 straight from the file, without touching level 0. Without it
+    // each would decode the whole image again, so they are halved from level 0 like the rest.
+    const Asset source = loadAsset(assetName.c_str());
+    if (level == 0 || (level <= 3 && imageDecodeScalesInDct(source.data, source.size))) {
+        pixels.resize(static_cast<size_t>(w) * h * 4 + imageDecodeHeadroom);
+        if (!decodeImageInto(source.data, source.size, pixels.data(), pixels.size(), w, h, 4, 1 << level)) {
+            std::cerr << "❌ Decoding level " << level << " of " << assetName << " failed\n";
+            std::fill(pixels.begin(), pixels.end(), 0);
+        }
+        pixels.resize(static_cast<size_t>(w) * h * 4);
+        return pixels;
+    }
+
+    // Otherwise halve the level above; sizes round up, so the last row or column is repeated.
+    const std::vector<unsigned char>& above = decodeLevel(level - 1);
+    const int aboveWidth = levelWidth(level - 1), aboveHeight = levelHeight(level - 1);
+    pixels.resize(static_cast<size_t>(w) * h * 4);
+    for (int y = 0; y < h; ++y) {
+        const int y0 = 2 * y, y1 = std::min(2 * y + 1, aboveHeight - 1);
+        for (int x = 0; x < w; ++x) {
+            const int x0 = 2 * x, x1 = std::min(2 * x + 1, aboveWidth - 1);
+            for (int c = 0; c < 4; ++c) {
+                const int sum = above[(static_cast<size_t>(y0) * aboveWidth + x0) * 4 + c] + above[(static_cast<size_t>(y0) * aboveWidth + x1) * 4 + c] +
+                                above[(static_cast<size_t>(y1) * aboveWidth + x0) * 4 + c] + above[(static_cast<size_t>(y1) * aboveWidth + x1) * 4 + c];
+                pixels[(static_cast<size_t>(y) * w + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+            }
+        }
+    }
+    return pixels;
+}
+
+VirtualTexture::DecodedTile VirtualTexture::cutTile(const VirtualTile& tile) {
+    const std::vector<unsigned char>& pixels = decodeLevel(tile.level);
+    const int w = levelWidth(tile.level), h = levelHeight(tile.level);
+    const int slotSize = tileSize + 2 * border;
+
+    // The texture wraps around the pawn, so borders (and the rest of a partial edge tile) wrap too.
+    DecodedTile decoded{ tile, std::vector<unsigned char>(static_cast<size_t>(slotSize) * slotSize * 4) };
+    for (int y = 0; y < slotSize; ++y) {
+        const int sy = ((tile.y * tileSize + y - border) % h + h) % h;
+        for (int x = 0; x < slotSize; ++x) {
+            const int sx = ((tile.x * tileSize + x - border) % w + w) % w;
+            std::copy_n(pixels.data() + (static_cast<size_t>(sy) * w + sx) * 4, 4, decoded.rgba.data() + (static_cast<size_t>(y) * slotSize + x) * 4);
+        }
+    }
+    return decoded;
+}
+
+void VirtualTexture::startDecode() {
+    std::vector<VirtualTile> batch;
+    size_t taken = 0;
+    for (; taken < wanted.size() && batch.size() < tilesPerBatch; ++taken) {
+        const uint64_t tileKey = key(wanted[taken]);
+        if (residentSlots.contains(tileKey)) {
+            continue;
+        }
+        // Evicted but still cached: straight back to the upload queue, which caches it again.
+        if (auto it = tileCache.find(tileKey); it != tileCache.end()) {
+            ready.push_back({ wanted[taken], std::move(it->second.rgba) });
+            tileCache.erase(it);
+            continue;
+        }
+        batch.push_back(wanted[taken]);
+    }
+    wanted.erase(wanted.begin(), wanted.begin() + static_cast<long>(taken));
+    if (batch.empty()) {
+        return;
+    }
+
+    // One job at a time, so the level cache is only ever touched by one worker.
+    job = std::async(std::launch::async, [this, batch = std::move(batch)] {
+        std::vector<DecodedTile> decoded;
+        decoded.reserve(batch.size());
+        for (const VirtualTile& tile : batch) {
+            decoded.push_back(cutTile(tile));
+        }
+        return decoded;
+    });
+}
+
+void VirtualTexture::releaseLevels() {
+    // A decoded level is only kept while tiles of it are still waiting to be cut; tiles wanted
+    // again later come from the tile cache, or decode their level anew.
+    std::vector<bool> needed(levels, false);
+    for (const VirtualTile& tile : wanted) {
+        needed[tile.level] = true;
+    }
+    for (int level = 0; level < levels; ++level) {
+        if (!needed[level] && !levelCache[level].empty()) {
+            levelCache[level].clear();
+            levelCache[level].shrink_to_fit();
+        }
+    }
+}
+
+void VirtualTexture::uploadReady() {
+    const int slotSize = tileSize + 2 * border;
+
+    int uploaded = 0;
+    while (!ready.empty() && uploaded < tilesPerFrame) {
+        DecodedTile decoded = std::move(ready.front());
+        ready.erase(ready.begin());
+        if (residentSlots.contains(key(decoded.tile))) {
+            continue;
+        }
+
+        // Least recently seen slot; the pinned coarsest tile never is.
+        auto victim = std::ranges::min_element(slots, {}, &Slot::lastUsed);
+        if (victim->tile.level >= 0 && victim->lastUsed >= feedbackFrame) {
+            cacheTile(std::move(decoded));
+            continue;   // Every slot is in view: the pool is oversubscribed, stay with the coarser tile
+        }
+        if (victim->tile.level >= 0) {
+            residentSlots.erase(key(victim->tile));
+        }
+
+        const int slot = static_cast<int>(victim - slots.begin());
+        const bool pinned = decoded.tile.level == levels - 1;
+        *victim = { decoded.tile, pinned ? UINT64_MAX : frame };
+        residentSlots[key(decoded.tile)] = slot;
+
+        glState.textureSubImage2D(pool, GL_TEXTURE_2D, 0, (slot % poolTilesPerSide) * slotSize, (slot / poolTilesPerSide) * slotSize,
+                                  slotSize, slotSize, GL_RGBA, GL_UNSIGNED_BYTE, decoded.rgba.data());
+        if (!pinned && slots.size() < static_cast<size_t>(tileCount)) {
+            cacheTile(std::move(decoded));
+        }
+        pageTableDirty = true;
+        ++uploaded;
+    }
+}
+
+void VirtualTexture::cacheTile(DecodedTile&& decoded) {
+    if (tileCache.size() >= cachedTiles) {
+        tileCache.erase(std::ranges::min_element(tileCache, {}, [](const auto& entry) { return entry.second.lastUsed; }));
+    }
+    tileCache[key(decoded.tile)] = { std::move(decoded.rgba), frame };
+}
+
+void VirtualTexture::rebuildPageTable() {
+    // Coarse to fine, so an unmapped tile can inherit its parent's mapping.
+    for (int level = levels - 1; level >= 0; --level) {
+        for (int y = 0; y < tilesY(level); ++y) {
+            for (int x = 0; x < tilesX(level); ++x) {
+                unsigned char* entry = pageEntries.data() + (static_cast<size_t>(pageRowOffsets[level] + y) * pageTableWidth + x) * 4;
+                if (auto it = residentSlots.find(key({ level, x, y })); it != residentSlots.end()) {
+                    entry[0] = static_cast<unsigned char>(it->second % poolTilesPerSide);
+                    entry[1] = static_cast<unsigned char>(it->second / poolTilesPerSide);
+                    entry[2] = static_cast<unsigned char>(level);
+                    entry[3] = 255;
+                } else if (level + 1 < levels) {
+                    const unsigned char* parent = pageEntries.data() +
+                        (static_cast<size_t>(pageRowOffsets[level + 1] + y / 2) * pageTableWidth + x / 2) * 4;
+                    std::copy_n(parent, 4, entry);
+                } else {
+                    std::fill_n(entry, 4, 0);
+                }
+            }
+        }
+    }
+
+    glState.textureSubImage2D(pageTable, GL_TEXTURE_2D, 0, 0, 0, pageTableWidth, pageTableHeight, GL_RGBA, GL_UNSIGNED_BYTE, pageEntries.data());
+    pageTableDirty = false;
+}
+
+void VirtualTexture::update() {
+    if (!valid()) {
+        return;
+    }
+    ++frame;
+
+    readFeedback();
+
+    if (job.valid() && job.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        std::vector<DecodedTile> decoded = job.get();
+        ready.insert(ready.end(), std::make_move_iterator(decoded.begin()), std::make_move_iterator(decoded.end()));
+        releaseLevels();
+    }
+    uploadReady();
+    if (!job.valid() && ready.empty()) {
+        startDecode();
+    }
+
+    if (pageTableDirty) {
+        rebuildPageTable();
+    }
+}
+
+void VirtualTexture::bind(GLuint poolUnit, GLuint pageTableUnit) const {
+    glState.bindTexture(poolUnit, GL_TEXTURE_2D, pool);
+    glState.bindTexture(pageTableUnit, GL_TEXTURE_2D, pageTable);
+}
@@ -0,0 +1,127 @@
+#ifndef VIRTUALTEXTURE_H
+#define VIRTUALTEXTURE_H
+#include <GL/glew.h>
+
+#include <array>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// GLSL for `streamedMarbleLod(uv)` and `streamedMarble(uv, lod)`; see VirtualTexture::setUniforms().
+extern const char* const streamedMarbleGLSL;
+
+struct VirtualTile {
+    int level, x, y;
+
+    bool operator==(const VirtualTile&) const = default;
+};
+
+class VirtualTexture {
+    /*
+     * A large image split into tiles per mip level, of which only the ones the camera needs are
+     * decoded and kept on the GPU, in a fixed-size tile pool, no larger than all the tiles together. A page table texture (one texel per
+     * tile, each level in its own band of rows) maps every tile to its pool slot, or to the slot of
+     * its nearest resident ancestor. The coarsest level is a single tile that is never evicted.
+     *
+     * Which tiles are needed comes from a feedback pass: the marble drawn at 1/`feedbackDivisor` of
+     * the viewport, writing tile and level per pixel, read back through a PBO a few frames later.
+     * Levels are decoded from the JPEG on a worker (DCT-scaled where possible) and kept on the CPU only
+     * while tiles of them are still wanted; the last few tiles uploaded are kept too, so a tile evicted
+     * and wanted again skips the worker. The pool stays below the plain mipmapped texture, or the
+     * source is not streamed at all (valid() is false).
+     */
+
+    public:
+        // Up to 256 tiles per side at level 0; larger sources are rejected (valid() is false).
+        explicit VirtualTexture(const std::string& assetName, int tileSize = 128, int maxPoolTilesPerSide = 8);
+        ~VirtualTexture();
+        VirtualTexture(const VirtualTexture&) = delete;
+        VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+        [[nodiscard]] bool valid() const { return levels > 0; }
+
+        // Sizes and page table layout for the streamedMarbleGLSL uniforms; samplers are set by setupShaders().
+        void setUniforms(GLuint program) const;
+
+        // Draw the surfaces that use the texture between these two, with the attributes of the main programs
+        // and the current Frame uniform block; draw occluders first with color writes masked off.
+        // Skipped (returns false) while the previous readback is in flight.
+        bool beginFeedback();
+        void endFeedback();
+
+        // Consume finished readbacks and decodes, upload up to `tilesPerFrame` tiles and refresh the page table.
+        void update();
+
+        void bind(GLuint poolUnit, GLuint pageTableUnit) const;
+
+    private:
+        struct DecodedTile {
+            VirtualTile tile;
+            std::vector<unsigned char> rgba;    // (tileSize + 2 * border)² texels
+        };
+
+        struct Slot {
+            VirtualTile tile{ -1, 0, 0 };
+            uint64_t lastUsed = 0;
+        };
+
+        struct CachedTile {
+            std::vector<unsigned char> rgba;
+            uint64_t lastUsed = 0;
+        };
+
+        static constexpr int border = 2;            // Wrapped texels around each tile, for bilinear filtering
+        static constexpr int feedbackDivisor = 8;
+        static constexpr int tilesPerFrame = 4;
+        static constexpr int tilesPerBatch = 8;
+        static constexpr size_t cachedTiles = 16;   // Uploaded tiles kept on the CPU, about 1.1 MiB
+
+        std::string assetName;
+        int width = 0, height = 0;
+        int tileSize, poolTilesPerSide;
+        int levels = 0;
+        int tileCount = 0;                          // Over all levels
+        std::vector<int> pageRowOffsets;            // First page table row of each level
+
+        GLuint pool = 0, pageTable = 0;
+        int pageTableWidth = 0, pageTableHeight = 0;
+        std::vector<Slot> slots;
+        std::unordered_map<uint64_t, int> residentSlots;    // Tile key → slot
+        std::unordered_map<uint64_t, CachedTile> tileCache;    // Tile key → its slot's texels, main thread only
+        std::vector<unsigned char> pageEntries;
+        bool pageTableDirty = true;
+        uint64_t frame = 0;
+        uint64_t feedbackFrame = 0;                 // When the latest feedback was read; tiles it saw are not evicted
+
+        bool feedbackProgramLinked = false;
+        GLuint feedbackProgram = 0, feedbackFbo = 0, feedbackColor = 0, feedbackDepth = 0, feedbackPbo = 0;
+        int feedbackWidth = 0, feedbackHeight = 0;
+        std::array<GLint, 4> previousViewport{};
+        GLuint previousProgram = 0;
+        GLuint previousFramebuffer = 0;
+        GLsync feedbackFence = nullptr;
+
+        std::vector<VirtualTile> wanted;            // From the latest feedback, coarsest first
+        std::future<std::vector<DecodedTile>> job;
+        std::vector<DecodedTile> ready;
+        std::vector<std::vector<unsigned char>> levelCache;    // Worker-only while a job runs; see releaseLevels()
+
+        [[nodiscard]] int levelWidth(int level) const;
+        [[nodiscard]] int levelHeight(int level) const;
+        [[nodiscard]] int tilesX(int level) const;
+        [[nodiscard]] int tilesY(int level) const;
+        [[nodiscard]] uint64_t key(const VirtualTile& tile) const;
+
+        void readFeedback();
+        void startDecode();
+        void releaseLevels();
+        void uploadReady();
+        void cacheTile(DecodedTile&& decoded);
+        void rebuildPageTable();
+        const std::vector<unsigned char>& decodeLevel(int level);
+        [[nodiscard]] DecodedTile cutTile(const VirtualTile& tile);
+};
+
+#endif //VIRTUALTEXTURE_H